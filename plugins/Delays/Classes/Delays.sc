@@ -1,9 +1,37 @@
-GrainDelay : UGen {
+GrainDelay : MultiOutUGen {
     *ar { |input, triggerRate = 10, overlap = 1, 
         delayTime = 0.2, grainRate = 1.0, mix = 0.5, 
-        feedback = 0.0, damping = 0.7, freeze = 0, reset = 0|
+        feedback = 0.0, damping = 0.7, freeze = 0, reset = 0, maxVoices = 16,
+        voicePolicy = 0, maxDelay = 2, buffer = -1, bufferMode = 0, voiceStats = false|
         
         ^this.multiNew('audio', input, triggerRate, overlap, 
-            delayTime, grainRate, mix, feedback, damping, freeze, reset)
+            delayTime, grainRate, mix, feedback, damping, freeze, reset, maxVoices,
+            voicePolicy, maxDelay, buffer ? -1, bufferMode, voiceStats.asInteger.clip(0, 1))
     }
-}
\ No newline at end of file
+
+    init { arg ... theInputs;
+        inputs = theInputs;
+        ^this.initOutputs(1 + inputs.last, rate);  // inputs.last is voiceStats
+    }
+}
+
+MultiGrainDelay : MultiOutUGen {
+    *ar { |input, triggerRate = 10, overlap = 1, 
+        delayTime = 0.2, grainRate = 1.0, mix = 0.5, 
+        feedback = 0.0, damping = 0.7, freeze = 0, reset = 0, maxVoices = 16,
+        voicePolicy = 0, maxDelay = 2|
+
+        // One tap per element of the widest per-tap argument, shorter ones wrap
+        var tapArgs = [triggerRate, overlap, delayTime, grainRate].collect(_.asArray);
+        var numTaps = tapArgs.maxValue(_.size).clip(1, 16);
+        var tapInputs = numTaps.collect { |tap| tapArgs.collect(_.wrapAt(tap)) }.flatten;
+
+        ^this.multiNewList(['audio', input, mix, feedback, damping, freeze, reset, maxVoices,
+            voicePolicy, maxDelay] ++ tapInputs)
+    }
+
+    init { arg ... theInputs;
+        inputs = theInputs;
+        ^this.initOutputs((inputs.size - 9) div: 4, rate);  // four inputs per tap after the shared ones
+    }
+}
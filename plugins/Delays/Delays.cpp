@@ -3,15 +3,241 @@
 
 extern InterfaceTable* ft;
 
+// ===== GRAIN READER =====
+
+GrainReader::GrainData GrainReader::startGrain(const GrainEvent& event) {
+    GrainData grain;
+    grain.readIndex = event.readIndex;
+    grain.readFrac = event.readFrac;
+    grain.rate = event.rate;
+    grain.sampleCount = event.offset;
+    grain.envSlope = event.envSlope;
+    grain.envPhase = event.envSlope * event.offset;
+    grain.active = true;
+    return grain;
+}
+
+int GrainReader::spanLength(const GrainData& grain, int start, int end) {
+
+    // The span ends with the block or once the window completes, at least one sample is rendered
+    return static_cast<int>(sc_clip(
+        std::ceil((1.0 - grain.envPhase) / grain.envSlope),
+        1.0, static_cast<double>(end - start)
+    ));
+}
+
+bool GrainReader::readsBlockWrites(const GrainData& grain, int start, int end) const {
+
+    // Cubic reads of the span cover [first - 1, last + 2], check them against the write region
+    const int count = spanLength(grain, start, end);
+    const double firstOffset = grain.readFrac + (grain.sampleCount * grain.rate);
+    const double lastOffset = grain.readFrac + ((grain.sampleCount + (count - 1)) * grain.rate);
+    const int lo = grain.readIndex + static_cast<int>(firstOffset) - 1;
+    const int hi = grain.readIndex + static_cast<int>(lastOffset) + 2;
+    const int offset = (lo - blockWritePos) & bufMask;
+    return offset < blockWrites || offset + (hi - lo) >= bufSize;
+}
+
+int GrainReader::renderGrain(GrainData& grain, int start, int end, float gain, float gainSlope) {
+
+    // Keep the grain state local for the whole span
+    const int readIndex = grain.readIndex;
+    const double readFrac = grain.readFrac;
+    const double rate = grain.rate;
+    const double envPhaseInc = grain.envSlope;
+    const double envPhase = grain.envPhase;
+    const double sampleCount = grain.sampleCount;
+    const int count = spanLength(grain, start, end);
+
+    // Four samples at a time: read positions, window phases and fade gain are linear across the span.
+    // Positions are offsets from the grain start in double, split into frame and fraction per read
+    int indices[4];
+    float fracs[4], phases[4], samples[4], windows[4];
+    int k = 0;
+
+    for (; k + 4 <= count; k += 4) {
+        for (int j = 0; j < 4; ++j) {
+            const double offset = readFrac + ((sampleCount + (k + j)) * rate);
+            const int frames = static_cast<int>(offset);
+            indices[j] = readIndex + frames;
+            fracs[j] = static_cast<float>(offset - frames);
+            phases[j] = static_cast<float>(envPhase + (k + j) * envPhaseInc);
+        }
+
+        // Get samples with interpolation and apply Hanning window
+        Utils::peekCubicInterp4(buffer, indices, fracs, bufMask, samples);
+        Utils::hanningWindow4(phases, windows);
+
+        for (int j = 0; j < 4; ++j) {
+            delayedBlock[start + k + j] += samples[j] * windows[j] * (gain + static_cast<float>(k + j) * gainSlope);
+        }
+    }
+
+    // Remaining samples one at a time
+    for (; k < count; ++k) {
+        const double offset = readFrac + ((sampleCount + k) * rate);
+        const int frames = static_cast<int>(offset);
+        float grainSample = Utils::peekCubicInterp(buffer, readIndex + frames, static_cast<float>(offset - frames), bufMask);
+        float window = Utils::hanningWindow(static_cast<float>(envPhase + k * envPhaseInc));
+        delayedBlock[start + k] += grainSample * window * (gain + static_cast<float>(k) * gainSlope);
+    }
+
+    // Store grain state, the voice is freed once its window completes
+    grain.envPhase = envPhase + count * envPhaseInc;
+    grain.sampleCount = sampleCount + count;
+    if (grain.envPhase >= 1.0) {
+        grain.active = false;
+    }
+
+    return start + count;
+}
+
+bool GrainReader::renderTail(GrainTail& tail, int start, int end) {
+
+    // Linear fade-out over the remaining steal fade samples
+    const float fadeStep = 1.0f / static_cast<float>(stealFadeSamples);
+    const int stop = renderGrain(
+        tail.grain,
+        start, sc_min(end, start + tail.remaining),
+        static_cast<float>(tail.remaining) * fadeStep, -fadeStep
+    );
+
+    tail.remaining -= stop - start;
+    return tail.remaining > 0 && tail.grain.active;
+}
+
+template<int NumVoices>
+bool GrainReader::isBlockSafe(const EventUtils::VoiceMask<NumVoices>& liveVoices, int nSamples) const {
+
+    // Grain voices
+    const auto& voices = *static_cast<const VoiceBank<NumVoices>*>(voiceBank);
+
+    // Stolen grains still fading out from earlier samples
+    for (int g : voices.fading) {
+        const GrainTail& tail = voices.tails[g];
+        if (readsBlockWrites(tail.grain, 0, sc_min(nSamples, tail.remaining))) {
+            return false;
+        }
+    }
+
+    // Running grains, a grain stolen within the block keeps its read path while it fades out
+    for (int g : liveVoices) {
+        const GrainData& grain = voices.grainData[g];
+        if (grain.active && readsBlockWrites(grain, 0, nSamples)) {
+            return false;
+        }
+    }
+
+    // Grains triggered within the block
+    for (int e = 0; e < numEvents; ++e) {
+        if (readsBlockWrites(startGrain(events[e]), events[e].sample, nSamples)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<int NumVoices>
+bool GrainReader::renderBlock(const EventUtils::VoiceMask<NumVoices>& liveVoices, int nSamples) {
+
+    // Grain voices
+    auto& voices = *static_cast<VoiceBank<NumVoices>*>(voiceBank);
+
+    voices.eventCursors.fill(0);
+    memset(delayedBlock, 0, nSamples * sizeof(float));
+
+    // Grains reading this block's writes need sample-by-sample rendering instead
+    if (!isBlockSafe<NumVoices>(liveVoices, nSamples)) {
+        return false;
+    }
+
+    renderGrains<NumVoices>(liveVoices, 0, nSamples);
+    return true;
+}
+
+template<int NumVoices>
+void GrainReader::renderGrains(const EventUtils::VoiceMask<NumVoices>& liveVoices, int start, int end) {
+
+    // Grain voices
+    auto& voices = *static_cast<VoiceBank<NumVoices>*>(voiceBank);
+
+    // Stolen grains still fading out from earlier samples
+    for (int g : voices.fading) {
+        if (!renderTail(voices.tails[g], start, end)) {
+            voices.fading.clear(g);
+        }
+    }
+
+    for (int g : liveVoices) {
+
+        GrainData& grain = voices.grainData[g];
+        int& eventIndex = voices.eventCursors[g];
+        int i = start;
+
+        while (i < end) {
+
+            // The next trigger event of this voice bounds the current span
+            int eventSample = sc_min(EventUtils::nextVoiceEvent(events, numEvents, g, eventIndex, end), end);
+
+            if (i == eventSample) {
+
+                // Stolen voice: hand the running grain over to a short fade-out
+                if (grain.active) {
+                    GrainTail& tail = voices.tails[g];
+                    tail.grain = grain;
+                    tail.remaining = stealFadeSamples;
+                    if (renderTail(tail, i, end)) {
+                        voices.fading.set(g);
+                    } else {
+                        voices.fading.clear(g);
+                    }
+                }
+
+                // Store grain data of the triggered grain
+                grain = startGrain(events[eventIndex++]);
+
+                eventSample = sc_min(EventUtils::nextVoiceEvent(events, numEvents, g, eventIndex, end), end);
+
+            } else if (!grain.active) {
+
+                // Idle voice: jump to its next trigger event
+                i = eventSample;
+                continue;
+            }
+
+            i = renderGrain(grain, i, eventSample, 1.0f, 0.0f);
+        }
+    }
+}
+
+// ===== GRAIN DELAY =====
+
 GrainDelay::GrainDelay() : 
     m_sampleRate(static_cast<float>(sampleRate())),
     m_sampleDur(static_cast<float>(sampleDur())),
-    m_bufSize(NEXTPOWEROFTWO(static_cast<int>(MAX_DELAY_TIME * sampleRate()))),
-    m_bufFrames(static_cast<float>(m_bufSize)),
-    m_bufMask(m_bufSize - 1)
+    m_bufferMode(in0(BufNum) < 0.0f ? BufferMode::Internal :
+        in0(BufMode) > 0.5f ? BufferMode::Read : BufferMode::Write),
+    m_maxDelay(sc_clip(in0(MaxDelay), static_cast<float>(bufferSize()) * m_sampleDur, MAX_DELAY_LIMIT)),
+    m_numVoices(EventUtils::resolveVoiceCount(in0(MaxVoices))),
+    m_voicePolicy(EventUtils::resolveVoicePolicy(in0(VoicePolicy))),
+    m_stealFadeSamples(sc_max(static_cast<int>(EventUtils::STEAL_FADE_TIME * m_sampleRate), 1)),
+    m_overflowOutput(numOutputs() > 1)
 {
+    // Size the private delay line for the requested max delay and the interpolation taps behind it,
+    // an external delay line is fetched here so its usable delay range is known
+    if (m_bufferMode == BufferMode::Internal) {
+        m_bufSize = NEXTPOWEROFTWO(static_cast<int>(m_maxDelay * sampleRate()) + GrainReader::INTERP_TAPS);
+        m_bufMask = m_bufSize - 1;
+        m_maxDelayTime = m_maxDelay;
+    } else {
+        acquireBuffer();
+    }
+
+    m_reader.stealFadeSamples = m_stealFadeSamples;
+
     // Initialize parameter cache
-    delayTimePast = sc_clip(in0(DelayTime), m_sampleDur, MAX_DELAY_TIME);
+    delayTimePast = sc_clip(in0(DelayTime), m_sampleDur, m_maxDelayTime);
     mixPast = sc_clip(in0(Mix), 0.0f, 1.0f);
     feedbackPast = sc_clip(in0(Feedback), 0.0f, 0.99f);
     dampingPast = sc_clip(in0(Damping), 0.0f, 1.0f);
@@ -27,12 +253,27 @@ GrainDelay::GrainDelay() :
     isFreezeAudioRate = isAudioRateIn(Freeze);
     isResetAudioRate = isAudioRateIn(Reset);
 
-    // Allocate audio buffer
-    auto unit = this;
-    PluginUtils::allocBuffer(unit, mWorld, m_bufSize, m_buffer);
-    
-    // Set calc function & compute initial sample
-    set_calc_function<GrainDelay, &GrainDelay::next>();
+    // Resolve voice count into allocator instantiation & compute initial sample
+    switch (m_numVoices) {
+        case 4:
+            setCalcFunction<4>();
+            break;
+        case 8:
+            setCalcFunction<8>();
+            break;
+        case 32:
+            setCalcFunction<32>();
+            break;
+        case 64:
+            setCalcFunction<64>();
+            break;
+        case 128:
+            setCalcFunction<128>();
+            break;
+        default:
+            setCalcFunction<16>();
+            break;
+    }
 
     // Reset state after priming
     m_scheduler.reset();
@@ -40,158 +281,534 @@ GrainDelay::GrainDelay() :
 }
 
 GrainDelay::~GrainDelay() {
-    RTFree(mWorld, m_buffer);
+    m_arena.free(mWorld);
+}
+
+template<int NumVoices>
+void GrainDelay::setCalcFunction() {
+
+    // Allocate grain voices, private audio buffer and block buffers for voice-major rendering in one block
+    auto unit = this;
+    GrainReader::VoiceBank<NumVoices>* voices = nullptr;
+    m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+        voices = arena.object<GrainReader::VoiceBank<NumVoices>>();
+        if (m_bufferMode == BufferMode::Internal) {
+            m_buffer = arena.buffer<float>(m_bufSize);
+        }
+        m_reader.events = arena.buffer<GrainReader::GrainEvent>(bufferSize());
+        m_reader.delayedBlock = arena.buffer<float>(bufferSize());
+        m_compensationBlock = arena.buffer<float>(bufferSize());
+        if (m_overflowOutput) {
+            m_overflowBlock = arena.buffer<float>(bufferSize());
+        }
+    });
+    if (!voices) {
+        return;
+    }
+    m_reader.voiceBank = voices;
+    voices->allocator.policy = m_voicePolicy;
+
+    set_calc_function<GrainDelay, &GrainDelay::next<NumVoices>>();
+}
+
+bool GrainDelay::acquireBuffer() {
+
+    auto table = m_bufUnit.GetTable(this, in0(BufNum), "GrainDelay");
+    if (!table.valid) {
+        return false;
+    }
+
+    // Interleaved channels would need strided access, and a ring shorter than two blocks
+    // cannot hold a block of writes apart from the reads
+    const SndBuf* buf = m_bufUnit.m_buf;
+    int ringSize = 1;
+    while (ringSize * 2 <= buf->frames) {
+        ringSize *= 2;
+    }
+    if (buf->channels != 1 || ringSize < bufferSize() * 2) {
+        if (!m_bufFailed) {
+            Print("GrainDelay: buffer has to be mono with at least %d frames\n", bufferSize() * 2);
+            m_bufFailed = true;
+        }
+        return false;
+    }
+    m_bufFailed = false;
+
+    m_buffer = buf->data;
+    m_bufSize = ringSize;
+    m_bufMask = ringSize - 1;
+    m_maxDelayTime = sc_min(m_maxDelay, static_cast<float>(ringSize - bufferSize()) * m_sampleDur);
+
+    // The write head follows the server clock, so all units sharing the buffer agree on it.
+    // Unsigned wrap-around keeps the position continuous for any power-of-two ring
+    const uint32 clock = static_cast<uint32>(mWorld->mBufCounter) * static_cast<uint32>(bufferSize());
+    m_writePos = static_cast<int>(clock & static_cast<uint32>(m_bufMask));
+
+    return true;
 }
 
+template<int NumVoices>
 void GrainDelay::next(int nSamples) {
-    
+
+    // Grain voices
+    auto& voices = *static_cast<GrainReader::VoiceBank<NumVoices>*>(m_reader.voiceBank);
+
+    // External delay line, fetched every block as it may be reallocated
+    const bool external = m_bufferMode != BufferMode::Internal;
+    if (external && !acquireBuffer()) {
+        ClearUnitOutputs(this, nSamples);
+        return;
+    }
+
     // Audio-rate input
     const float* input = in(Input);
-    
+
     // Control-rate parameters with smooth interpolation
-    auto slopedDelayTime = makeSlope(sc_clip(in0(DelayTime), m_sampleDur, MAX_DELAY_TIME), delayTimePast);
+    auto slopedDelayTime = makeSlope(sc_clip(in0(DelayTime), m_sampleDur, m_maxDelayTime), delayTimePast);
     auto slopedMix = makeSlope(sc_clip(in0(Mix), 0.0f, 1.0f), mixPast);
     auto slopedFeedback = makeSlope(sc_clip(in0(Feedback), 0.0f, 0.99f), feedbackPast);
     auto slopedDamping = makeSlope(sc_clip(in0(Damping), 0.0f, 1.0f), dampingPast);
 
     // Output pointers
     float* output = out(Output);
-    
+
+    // 1. Resolve trigger events for the whole block, tracking the write head ahead of the writes
+    m_reader.numEvents = 0;
+
+    // Voices live at block start or triggered within it
+    EventUtils::VoiceMask<NumVoices> liveVoices = voices.allocator.active;
+    int writePos = m_writePos;
+
     for (int i = 0; i < nSamples; ++i) {
-        
+
         // Get current parameter values (no interpolation - latched per trigger)
-        float triggerRate = isTriggerRateAudioRate ? 
-            sc_clip(in(TriggerRate)[i], 0.1f, 500.0f) : 
+        float triggerRate = isTriggerRateAudioRate ?
+            sc_clip(in(TriggerRate)[i], 0.1f, 500.0f) :
             sc_clip(in0(TriggerRate), 0.1f, 500.0f);
-            
-        float overlap = isOverlapAudioRate ? 
-            sc_clip(in(Overlap)[i], 0.001f, static_cast<float>(NUM_VOICES)) : 
-            sc_clip(in0(Overlap), 0.001f, static_cast<float>(NUM_VOICES));
 
-        float grainRate = isGrainRateAudioRate ? 
-            sc_clip(in(GrainRate)[i], 0.125f, 4.0f) : 
+        float overlap = isOverlapAudioRate ?
+            sc_clip(in(Overlap)[i], 0.001f, static_cast<float>(NumVoices)) :
+            sc_clip(in0(Overlap), 0.001f, static_cast<float>(NumVoices));
+
+        float grainRate = isGrainRateAudioRate ?
+            sc_clip(in(GrainRate)[i], 0.125f, 4.0f) :
             sc_clip(in0(GrainRate), 0.125f, 4.0f);
-        
+
         // Get current parameter values (audio-rate or interpolated control-rate)
-        float delayTime = isDelayTimeAudioRate ? 
-            sc_clip(in(DelayTime)[i], m_sampleDur, MAX_DELAY_TIME) : 
+        float delayTime = isDelayTimeAudioRate ?
+            sc_clip(in(DelayTime)[i], m_sampleDur, m_maxDelayTime) :
             slopedDelayTime.consume();
 
-        float mix = isMixAudioRate ? 
-            sc_clip(in(Mix)[i], 0.0f, 1.0f) : 
-            slopedMix.consume();
-            
-        float feedback = isFeedbackAudioRate ? 
-            sc_clip(in(Feedback)[i], 0.0f, 0.99f) : 
-            slopedFeedback.consume();
-            
-        float damping = isDampingAudioRate ? 
-            sc_clip(in(Damping)[i], 0.0f, 1.0f) : 
-            slopedDamping.consume();
-
         // Freeze input (audio-rate or control-rate)
-        bool freeze = isFreezeAudioRate ? 
-            in(Freeze)[i] > 0.5f : 
+        bool freeze = isFreezeAudioRate ?
+            in(Freeze)[i] > 0.5f :
             in0(Freeze) > 0.5f;
 
         // Reset input (audio-rate or control-rate)
-        bool reset = isResetAudioRate ? 
-            m_resetTrigger.process(in(Reset)[i]) : 
+        bool reset = isResetAudioRate ?
+            m_resetTrigger.process(in(Reset)[i]) :
             m_resetTrigger.process(in0(Reset));
-        
-        // 1. Get event data from scheduler
+
+        // Get event data from scheduler
         auto scheduler = m_scheduler.process(triggerRate, reset, m_sampleRate);
-        
-        // 2. Process voice allocation with scaled rate
+
+        // Process voice allocation with scaled rate
         float rateScaled = scheduler.rate / overlap;
-        m_allocator.process(
-            scheduler.trigger, 
-            rateScaled, 
+        int voice = voices.allocator.process(
+            scheduler.trigger,
+            rateScaled,
             scheduler.subSampleOffset,
             m_sampleRate
         );
-        
-        // 3. Process all grains
-        float delayed = 0.0f;
-        for (int g = 0; g < NUM_VOICES; ++g) {
-
-            // Trigger new grain if needed
-            if (m_allocator.triggers[g]) {
-
-                // Calculate read position
-                float normalizedWritePos = static_cast<float>(m_writePos) / m_bufFrames;
-                float normalizedDelay = sc_max(m_sampleDur, delayTime * m_sampleRate / m_bufFrames);
-                float readPos = sc_frac(normalizedWritePos - normalizedDelay);
-                
-                // Store grain data
-                m_grainData[g].readPos = readPos;
-                m_grainData[g].rate = grainRate;
-                m_grainData[g].sampleCount = scheduler.subSampleOffset;
-            }
-            
-            // Process grain if voice allocator says it's active
-            if (m_allocator.isActive[g]) {
-                
-                // Calculate grain position: readPos + (accumulator * grainRate)
-                float grainPos = (m_grainData[g].readPos * m_bufFrames) + (m_grainData[g].sampleCount * m_grainData[g].rate);
-                
-                // Get sample with interpolation
-                float grainSample = Utils::peekCubicInterp(
-                    m_buffer, 
-                    grainPos,
-                    m_bufMask
-                );
-                
-                // Apply Hanning window using voice allocator's sub-sample accurate phase
-                grainSample *= sc_hanwindow(m_allocator.phases[g]);
-                delayed += grainSample;
-
-                // Increment sample count
-                m_grainData[g].sampleCount++;
-            }
+
+        if (voice >= 0) {
+
+            // Calculate read position as a frame plus fraction, exact on long delay lines
+            const double delayFrames = sc_max(GrainReader::MIN_DELAY_FRAMES, static_cast<double>(delayTime) * m_sampleRate);
+            const double startPos = static_cast<double>(writePos) - delayFrames;
+            const double startFrame = std::floor(startPos);
+
+            GrainReader::GrainEvent& event = m_reader.events[m_reader.numEvents++];
+            event.sample = i;
+            event.voice = voice;
+            liveVoices.set(voice);
+            event.readIndex = static_cast<int>(startFrame) & m_bufMask;
+            event.readFrac = startPos - startFrame;
+            event.rate = grainRate;
+            event.offset = scheduler.subSampleOffset;
+            event.envSlope = voices.allocator.localSlopes[voice];
+        }
+
+        if (m_overflowOutput) {
+            m_overflowBlock[i] = static_cast<float>(voices.allocator.overflowCount);
         }
 
-        // 4. Apply amplitude compensation based on overlap
+        // Amplitude compensation based on overlap
         float effectiveOverlap = sc_max(1.0f, overlap);
-        float compensationGain = 1.0f / std::sqrt(effectiveOverlap);
-        delayed *= compensationGain;
-        
-        // 5. Apply feedback with damping filter
+        m_compensationBlock[i] = 1.0f / std::sqrt(effectiveOverlap);
+
+        // Advance write head (only when not frozen, an external head always follows the clock)
+        if (!freeze || external) {
+            writePos = (writePos + 1) & m_bufMask;
+        }
+    }
+    m_reader.setDelayLine(m_buffer, m_bufSize, m_writePos, (writePos - m_writePos) & m_bufMask);
+
+    // 2. Render each voice across its live span of the block
+    const bool blockRendered = m_reader.renderBlock<NumVoices>(liveVoices, nSamples);
+
+    // 3. Feedback, buffer write and output mix
+    for (int i = 0; i < nSamples; ++i) {
+
+        // Grains reading this block's writes follow the writes sample by sample
+        if (!blockRendered) {
+            m_reader.renderGrains<NumVoices>(liveVoices, i, i + 1);
+        }
+
+        float mix = isMixAudioRate ?
+            sc_clip(in(Mix)[i], 0.0f, 1.0f) :
+            slopedMix.consume();
+
+        float feedback = isFeedbackAudioRate ?
+            sc_clip(in(Feedback)[i], 0.0f, 0.99f) :
+            slopedFeedback.consume();
+
+        float damping = isDampingAudioRate ?
+            sc_clip(in(Damping)[i], 0.0f, 1.0f) :
+            slopedDamping.consume();
+
+        // Freeze input (audio-rate or control-rate)
+        bool freeze = isFreezeAudioRate ?
+            in(Freeze)[i] > 0.5f :
+            in0(Freeze) > 0.5f;
+
+        // Apply amplitude compensation
+        float delayed = m_reader.delayedBlock[i] * m_compensationBlock[i];
+
+        // Apply feedback with damping filter
         float dampedFeedback = m_dampingFilter.processLowpass(delayed, damping);
         dampedFeedback = zapgremlins(dampedFeedback); // Prevent feedback buildup
-        
-        // 6. DC block input and write to delay buffer (only when not frozen)
+
+        // DC block input and write to delay buffer (only when not frozen and not reading only)
         float dcBlockedInput = m_dcBlocker.processHighpass(input[i], 3.0f, m_sampleRate);
-        
-        if (!freeze) {
+
+        if (!freeze && m_bufferMode != BufferMode::Read) {
             m_buffer[m_writePos] = dcBlockedInput + dampedFeedback * feedback;
+        }
+        if (!freeze || external) {
             m_writePos++;
             m_writePos = m_writePos & m_bufMask;
         }
-        
-        // 7. Output with wet/dry mix
+
+        // Output with wet/dry mix
         output[i] = lininterp(mix, input[i], delayed);
     }
-    
+
     // Update parameter cache (use last value if audio-rate, otherwise slope value)
-    delayTimePast = isDelayTimeAudioRate ? 
-        sc_clip(in(DelayTime)[nSamples - 1], m_sampleDur, MAX_DELAY_TIME) : 
+    delayTimePast = isDelayTimeAudioRate ?
+        sc_clip(in(DelayTime)[nSamples - 1], m_sampleDur, m_maxDelayTime) :
         slopedDelayTime.value;
 
-    mixPast = isMixAudioRate ? 
-        sc_clip(in(Mix)[nSamples - 1], 0.0f, 1.0f) : 
+    mixPast = isMixAudioRate ?
+        sc_clip(in(Mix)[nSamples - 1], 0.0f, 1.0f) :
+        slopedMix.value;
+
+    feedbackPast = isFeedbackAudioRate ?
+        sc_clip(in(Feedback)[nSamples - 1], 0.0f, 0.99f) :
+        slopedFeedback.value;
+
+    dampingPast = isDampingAudioRate ?
+        sc_clip(in(Damping)[nSamples - 1], 0.0f, 1.0f) :
+        slopedDamping.value;
+
+    // Running count of triggers which found all voices busy
+    if (m_overflowOutput) {
+        memcpy(out(Overflow), m_overflowBlock, nSamples * sizeof(float));
+    }
+}
+
+// ===== MULTI-TAP GRAIN DELAY =====
+
+MultiGrainDelay::MultiGrainDelay() :
+    m_sampleRate(static_cast<float>(sampleRate())),
+    m_sampleDur(static_cast<float>(sampleDur())),
+    m_maxDelay(sc_clip(in0(MaxDelay), static_cast<float>(bufferSize()) * m_sampleDur, MAX_DELAY_LIMIT)),
+    m_bufSize(NEXTPOWEROFTWO(static_cast<int>(m_maxDelay * sampleRate()) + GrainReader::INTERP_TAPS)),
+    m_bufMask(m_bufSize - 1),
+    m_numTaps(sc_clip(sc_min(static_cast<int>(numOutputs()), (static_cast<int>(numInputs()) - TapInputs) / NumTapParams), 1, MAX_TAPS)),
+    m_numVoices(EventUtils::resolveVoiceCount(in0(MaxVoices))),
+    m_voicePolicy(EventUtils::resolveVoicePolicy(in0(VoicePolicy))),
+    m_stealFadeSamples(sc_max(static_cast<int>(EventUtils::STEAL_FADE_TIME * m_sampleRate), 1))
+{
+    // Initialize parameter cache
+    mixPast = sc_clip(in0(Mix), 0.0f, 1.0f);
+    feedbackPast = sc_clip(in0(Feedback), 0.0f, 0.99f);
+    dampingPast = sc_clip(in0(Damping), 0.0f, 1.0f);
+
+    // Check which inputs are audio-rate
+    isMixAudioRate = isAudioRateIn(Mix);
+    isFeedbackAudioRate = isAudioRateIn(Feedback);
+    isDampingAudioRate = isAudioRateIn(Damping);
+    isFreezeAudioRate = isAudioRateIn(Freeze);
+    isResetAudioRate = isAudioRateIn(Reset);
+
+    for (int t = 0; t < m_numTaps; ++t) {
+        Tap& tap = m_taps[t];
+        tap.reader.stealFadeSamples = m_stealFadeSamples;
+        tap.delayTimePast = sc_clip(in0(tapInput(t, DelayTime)), m_sampleDur, m_maxDelay);
+        tap.isTriggerRateAudioRate = isAudioRateIn(tapInput(t, TriggerRate));
+        tap.isOverlapAudioRate = isAudioRateIn(tapInput(t, Overlap));
+        tap.isDelayTimeAudioRate = isAudioRateIn(tapInput(t, DelayTime));
+        tap.isGrainRateAudioRate = isAudioRateIn(tapInput(t, GrainRate));
+    }
+
+    // Resolve voice count into allocator instantiation & compute initial sample
+    switch (m_numVoices) {
+        case 4:
+            setCalcFunction<4>();
+            break;
+        case 8:
+            setCalcFunction<8>();
+            break;
+        case 32:
+            setCalcFunction<32>();
+            break;
+        case 64:
+            setCalcFunction<64>();
+            break;
+        case 128:
+            setCalcFunction<128>();
+            break;
+        default:
+            setCalcFunction<16>();
+            break;
+    }
+
+    // Reset state after priming
+    for (int t = 0; t < m_numTaps; ++t) {
+        m_taps[t].scheduler.reset();
+    }
+    m_resetTrigger.reset();
+}
+
+MultiGrainDelay::~MultiGrainDelay() {
+    m_arena.free(mWorld);
+}
+
+template<int NumVoices>
+void MultiGrainDelay::setCalcFunction() {
+
+    // Allocate the audio buffer and the grain voices and block buffers of all taps in one block
+    auto unit = this;
+    m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+        m_buffer = arena.buffer<float>(m_bufSize);
+        for (int t = 0; t < m_numTaps; ++t) {
+            Tap& tap = m_taps[t];
+            tap.reader.voiceBank = arena.object<GrainReader::VoiceBank<NumVoices>>();
+            tap.reader.events = arena.buffer<GrainReader::GrainEvent>(bufferSize());
+            tap.reader.delayedBlock = arena.buffer<float>(bufferSize());
+            tap.compensationBlock = arena.buffer<float>(bufferSize());
+        }
+    });
+    if (!m_arena.valid()) {
+        return;
+    }
+
+    for (int t = 0; t < m_numTaps; ++t) {
+        static_cast<GrainReader::VoiceBank<NumVoices>*>(m_taps[t].reader.voiceBank)->allocator.policy = m_voicePolicy;
+    }
+
+    set_calc_function<MultiGrainDelay, &MultiGrainDelay::next<NumVoices>>();
+}
+
+template<int NumVoices>
+void MultiGrainDelay::next(int nSamples) {
+
+    // Audio-rate input
+    const float* input = in(Input);
+
+    // Control-rate parameters with smooth interpolation
+    auto slopedMix = makeSlope(sc_clip(in0(Mix), 0.0f, 1.0f), mixPast);
+    auto slopedFeedback = makeSlope(sc_clip(in0(Feedback), 0.0f, 0.99f), feedbackPast);
+    auto slopedDamping = makeSlope(sc_clip(in0(Damping), 0.0f, 1.0f), dampingPast);
+
+    // 1. Resolve trigger events of each tap for the whole block, tracking the write head ahead of the writes
+    std::array<EventUtils::VoiceMask<NumVoices>, MAX_TAPS> liveVoices;
+
+    for (int t = 0; t < m_numTaps; ++t) {
+
+        Tap& tap = m_taps[t];
+        auto& voices = *static_cast<GrainReader::VoiceBank<NumVoices>*>(tap.reader.voiceBank);
+        auto slopedDelayTime = makeSlope(sc_clip(in0(tapInput(t, DelayTime)), m_sampleDur, m_maxDelay), tap.delayTimePast);
+
+        // Voices live at block start or triggered within it
+        tap.reader.numEvents = 0;
+        liveVoices[t] = voices.allocator.active;
+        int writePos = m_writePos;
+
+        // The reset trigger is shared, so each tap detects it on its own copy
+        EventUtils::IsTrigger resetTrigger = m_resetTrigger;
+
+        for (int i = 0; i < nSamples; ++i) {
+
+            // Get current parameter values (no interpolation - latched per trigger)
+            float triggerRate = tap.isTriggerRateAudioRate ?
+                sc_clip(in(tapInput(t, TriggerRate))[i], 0.1f, 500.0f) :
+                sc_clip(in0(tapInput(t, TriggerRate)), 0.1f, 500.0f);
+
+            float overlap = tap.isOverlapAudioRate ?
+                sc_clip(in(tapInput(t, Overlap))[i], 0.001f, static_cast<float>(NumVoices)) :
+                sc_clip(in0(tapInput(t, Overlap)), 0.001f, static_cast<float>(NumVoices));
+
+            float grainRate = tap.isGrainRateAudioRate ?
+                sc_clip(in(tapInput(t, GrainRate))[i], 0.125f, 4.0f) :
+                sc_clip(in0(tapInput(t, GrainRate)), 0.125f, 4.0f);
+
+            // Get current parameter values (audio-rate or interpolated control-rate)
+            float delayTime = tap.isDelayTimeAudioRate ?
+                sc_clip(in(tapInput(t, DelayTime))[i], m_sampleDur, m_maxDelay) :
+                slopedDelayTime.consume();
+
+            // Freeze input (audio-rate or control-rate)
+            bool freeze = isFreezeAudioRate ?
+                in(Freeze)[i] > 0.5f :
+                in0(Freeze) > 0.5f;
+
+            // Reset input (audio-rate or control-rate)
+            bool reset = isResetAudioRate ?
+                resetTrigger.process(in(Reset)[i]) :
+                resetTrigger.process(in0(Reset));
+
+            // Get event data from scheduler
+            auto scheduler = tap.scheduler.process(triggerRate, reset, m_sampleRate);
+
+            // Process voice allocation with scaled rate
+            float rateScaled = scheduler.rate / overlap;
+            int voice = voices.allocator.process(
+                scheduler.trigger,
+                rateScaled,
+                scheduler.subSampleOffset,
+                m_sampleRate
+            );
+
+            if (voice >= 0) {
+
+                // Calculate read position as a frame plus fraction, exact on long delay lines
+                const double delayFrames = sc_max(GrainReader::MIN_DELAY_FRAMES, static_cast<double>(delayTime) * m_sampleRate);
+                const double startPos = static_cast<double>(writePos) - delayFrames;
+                const double startFrame = std::floor(startPos);
+
+                GrainReader::GrainEvent& event = tap.reader.events[tap.reader.numEvents++];
+                event.sample = i;
+                event.voice = voice;
+                liveVoices[t].set(voice);
+                event.readIndex = static_cast<int>(startFrame) & m_bufMask;
+                event.readFrac = startPos - startFrame;
+                event.rate = grainRate;
+                event.offset = scheduler.subSampleOffset;
+                event.envSlope = voices.allocator.localSlopes[voice];
+            }
+
+            // Amplitude compensation based on overlap
+            float effectiveOverlap = sc_max(1.0f, overlap);
+            tap.compensationBlock[i] = 1.0f / std::sqrt(effectiveOverlap);
+
+            // Advance write head (only when not frozen)
+            if (!freeze) {
+                writePos = (writePos + 1) & m_bufMask;
+            }
+        }
+
+        // Update parameter cache (use last value if audio-rate, otherwise slope value)
+        tap.delayTimePast = tap.isDelayTimeAudioRate ?
+            sc_clip(in(tapInput(t, DelayTime))[nSamples - 1], m_sampleDur, m_maxDelay) :
+            slopedDelayTime.value;
+
+        // All taps see the same writes
+        tap.reader.setDelayLine(m_buffer, m_bufSize, m_writePos, (writePos - m_writePos) & m_bufMask);
+
+        // Keep the shared trigger state once the last tap has seen the block
+        if (t == m_numTaps - 1) {
+            m_resetTrigger = resetTrigger;
+        }
+    }
+
+    // 2. Render each voice of each tap across its live span of the block
+    for (int t = 0; t < m_numTaps; ++t) {
+        m_taps[t].blockRendered = m_taps[t].reader.renderBlock<NumVoices>(liveVoices[t], nSamples);
+    }
+
+    // 3. Feedback, buffer write and output mix
+    const float tapScale = 1.0f / static_cast<float>(m_numTaps);
+
+    for (int i = 0; i < nSamples; ++i) {
+
+        float mix = isMixAudioRate ?
+            sc_clip(in(Mix)[i], 0.0f, 1.0f) :
+            slopedMix.consume();
+
+        float feedback = isFeedbackAudioRate ?
+            sc_clip(in(Feedback)[i], 0.0f, 0.99f) :
+            slopedFeedback.consume();
+
+        float damping = isDampingAudioRate ?
+            sc_clip(in(Damping)[i], 0.0f, 1.0f) :
+            slopedDamping.consume();
+
+        // Freeze input (audio-rate or control-rate)
+        bool freeze = isFreezeAudioRate ?
+            in(Freeze)[i] > 0.5f :
+            in0(Freeze) > 0.5f;
+
+        const float dry = input[i];
+
+        // Each tap to its own output with wet/dry mix, the tap average is fed back
+        float delayedSum = 0.0f;
+        for (int t = 0; t < m_numTaps; ++t) {
+            Tap& tap = m_taps[t];
+
+            // Grains reading this block's writes follow the writes sample by sample
+            if (!tap.blockRendered) {
+                tap.reader.renderGrains<NumVoices>(liveVoices[t], i, i + 1);
+            }
+
+            // Apply amplitude compensation
+            float delayed = tap.reader.delayedBlock[i] * tap.compensationBlock[i];
+            delayedSum += delayed;
+
+            out(t)[i] = lininterp(mix, dry, delayed);
+        }
+
+        // Apply feedback with damping filter
+        float dampedFeedback = m_dampingFilter.processLowpass(delayedSum * tapScale, damping);
+        dampedFeedback = zapgremlins(dampedFeedback); // Prevent feedback buildup
+
+        // DC block input and write to delay buffer (only when not frozen)
+        float dcBlockedInput = m_dcBlocker.processHighpass(dry, 3.0f, m_sampleRate);
+
+        if (!freeze) {
+            m_buffer[m_writePos] = dcBlockedInput + dampedFeedback * feedback;
+            m_writePos++;
+            m_writePos = m_writePos & m_bufMask;
+        }
+    }
+
+    // Update parameter cache (use last value if audio-rate, otherwise slope value)
+    mixPast = isMixAudioRate ?
+        sc_clip(in(Mix)[nSamples - 1], 0.0f, 1.0f) :
         slopedMix.value;
-        
-    feedbackPast = isFeedbackAudioRate ? 
-        sc_clip(in(Feedback)[nSamples - 1], 0.0f, 0.99f) : 
+
+    feedbackPast = isFeedbackAudioRate ?
+        sc_clip(in(Feedback)[nSamples - 1], 0.0f, 0.99f) :
         slopedFeedback.value;
-        
-    dampingPast = isDampingAudioRate ? 
-        sc_clip(in(Damping)[nSamples - 1], 0.0f, 1.0f) : 
+
+    dampingPast = isDampingAudioRate ?
+        sc_clip(in(Damping)[nSamples - 1], 0.0f, 1.0f) :
         slopedDamping.value;
 }
 
 void Delays_setup()
 {
     registerUnit<GrainDelay>(ft, "GrainDelay", false);
+    registerUnit<MultiGrainDelay>(ft, "MultiGrainDelay", false);
 }
\ No newline at end of file
@@ -5,43 +5,163 @@
 #include "PluginUtils.hpp"
 #include <array>
 
+// ===== GRAIN READER =====
+
+// Grain voices reading a power-of-two delay line, one reader per grain stream. Trigger events
+// are resolved for the whole block first, then each voice is rendered across its live span.
+struct GrainReader {
+
+    // Cubic reads span one frame behind to two frames ahead of the read position
+    static constexpr int INTERP_TAPS = 4;
+
+    // Shortest grain delay in frames, two frames plus the look-ahead of the cubic reads
+    static constexpr double MIN_DELAY_FRAMES = 4.0;
+
+    // Grain data structure, the start frame is kept as an integer plus fraction and the read
+    // position advances in double, so long delay lines keep a fine interpolation fraction
+    struct GrainData {
+        int readIndex = 0;
+        double readFrac = 0.0;
+        float rate = 1.0f;
+        double sampleCount = 0.0;
+        
+        // Window phase, mirrors the voice allocator across blocks
+        double envSlope = 0.0;
+        double envPhase = 0.0;
+        bool active = false;
+    };
+    
+    // Stolen grain fading out while its voice restarts
+    struct GrainTail {
+        GrainData grain;
+        int remaining = 0;
+    };
+    
+    // Grain voices, sized by the voice count selected at construction
+    template<int NumVoices>
+    struct VoiceBank {
+        EventUtils::VoiceAllocator<NumVoices> allocator;
+        std::array<GrainData, NumVoices> grainData;
+        std::array<GrainTail, NumVoices> tails;
+        EventUtils::VoiceMask<NumVoices> fading;
+        std::array<int, NumVoices> eventCursors{};
+    };
+    
+    // Trigger event resolved by the voice allocator
+    struct GrainEvent {
+        int sample;
+        int voice;
+        int readIndex;
+        double readFrac;
+        float rate;
+        float offset;
+        double envSlope;
+    };
+
+    // Delay line and the region written to it in the current block, set by the owning unit
+    const float* buffer{nullptr};
+    int bufSize{0};
+    int bufMask{0};
+    int blockWritePos{0};
+    int blockWrites{0};
+    int stealFadeSamples{1};
+
+    // Block state for voice-major rendering
+    void* voiceBank{nullptr};
+    GrainEvent* events{nullptr};
+    float* delayedBlock{nullptr};
+    int numEvents{0};
+
+    void setDelayLine(const float* delayLine, int size, int writePos, int writes) {
+        buffer = delayLine;
+        bufSize = size;
+        bufMask = size - 1;
+        blockWritePos = writePos;
+        blockWrites = writes;
+    }
+
+    // Render the whole block into delayedBlock. Returns false without rendering if a grain would read
+    // the region written in this block, renderGrains then has to follow the writes per sample
+    template<int NumVoices>
+    bool renderBlock(const EventUtils::VoiceMask<NumVoices>& liveVoices, int nSamples);
+
+    template<int NumVoices>
+    void renderGrains(const EventUtils::VoiceMask<NumVoices>& liveVoices, int start, int end);
+
+    // Decide from the running grains and the trigger events whether no read of the block touches
+    // the region written in it, so the per-sample fallback never has to undo a rendered block
+    template<int NumVoices>
+    bool isBlockSafe(const EventUtils::VoiceMask<NumVoices>& liveVoices, int nSamples) const;
+
+    // True if the reads of a grain from start until end or its window completes touch the region written in this block
+    bool readsBlockWrites(const GrainData& grain, int start, int end) const;
+
+    // Grain started by a trigger event
+    static GrainData startGrain(const GrainEvent& event);
+
+    // Samples from start until end or the grain window completes, at least one
+    static int spanLength(const GrainData& grain, int start, int end);
+    
+    // Render a grain from start until end or its window completes, returns the stop sample
+    int renderGrain(GrainData& grain, int start, int end, float gain, float gainSlope);
+    
+    // Render a stolen grain along its fade-out, returns true while it is still fading
+    bool renderTail(GrainTail& tail, int start, int end);
+};
+
+// ===== GRAIN DELAY =====
+
 class GrainDelay : public SCUnit {
 public:
     GrainDelay();
     ~GrainDelay();
  
 private:
+    template<int NumVoices>
+    void setCalcFunction();
+    template<int NumVoices>
     void next(int nSamples);
+    bool acquireBuffer();
     
     // Constants
-    static constexpr int NUM_VOICES = 16;
-    static constexpr float MAX_DELAY_TIME = 2.0f;
+    static constexpr float MAX_DELAY_LIMIT = 60.0f;
+
+    // Delay line source, fixed at construction
+    enum class BufferMode {
+        Internal,   // private ring buffer sized by maxDelay
+        Write,      // records into an external buffer
+        Read        // only reads an external buffer recorded elsewhere
+    };
     
     // Constants cached at construction
     const float m_sampleRate;
     const float m_sampleDur;
-    const int m_bufSize;
-    const float m_bufFrames;
-    const int m_bufMask;
+    const BufferMode m_bufferMode;
+    const float m_maxDelay;
+    const int m_numVoices;
+    const EventUtils::VoicePolicy m_voicePolicy;
+    const int m_stealFadeSamples;
+    const bool m_overflowOutput;
     
     // Core trigger system
     EventUtils::SchedulerCycle m_scheduler;
-    EventUtils::VoiceAllocator<NUM_VOICES> m_allocator;
     EventUtils::IsTrigger m_resetTrigger;
     
-    // Audio buffer and processing
+    // Audio buffer and processing, the external delay line uses the largest power-of-two
+    // number of frames of its buffer and is fetched every block
+    PluginUtils::BufUnit m_bufUnit;
+    bool m_bufFailed{false};
     float *m_buffer{nullptr};
+    int m_bufSize{0};
+    int m_bufMask{0};
+    float m_maxDelayTime{0.0f};
     int m_writePos = 0;
     
-    // Grain data structure
-    struct GrainData {
-        float readPos = 0.0f;
-        float rate = 1.0f;
-        float sampleCount = 0.0f;
-    };
-    
-    // Grain voices
-    std::array<GrainData, NUM_VOICES> m_grainData;
+    // Grain voices and block buffers, carved out of one RT allocation together with the audio buffer
+    GrainReader m_reader;
+    PluginUtils::RTArena m_arena;
+    float* m_compensationBlock{nullptr};
+    float* m_overflowBlock{nullptr};
     
     // Feedback processing filters
     FilterUtils::OnePoleDirect m_dampingFilter;
@@ -74,10 +194,116 @@ private:
         Feedback,
         Damping,
         Freeze,
-        Reset
+        Reset,
+        MaxVoices,
+        VoicePolicy,
+        MaxDelay,
+        BufNum,
+        BufMode,
+        VoiceStats
     };
     
     enum Outputs {
-        Output        
+        Output,
+        Overflow
+    };
+};
+
+// ===== MULTI-TAP GRAIN DELAY =====
+
+// Several grain streams with their own trigger rate, overlap, delay time and grain rate,
+// reading one delay line written once per sample. Each tap has its own output channel.
+class MultiGrainDelay : public SCUnit {
+public:
+    MultiGrainDelay();
+    ~MultiGrainDelay();
+ 
+private:
+    template<int NumVoices>
+    void setCalcFunction();
+    template<int NumVoices>
+    void next(int nSamples);
+    
+    // Constants
+    static constexpr int MAX_TAPS = 16;
+    static constexpr float MAX_DELAY_LIMIT = 60.0f;
+    
+    // Constants cached at construction
+    const float m_sampleRate;
+    const float m_sampleDur;
+    const float m_maxDelay;
+    const int m_bufSize;
+    const int m_bufMask;
+    const int m_numTaps;
+    const int m_numVoices;
+    const EventUtils::VoicePolicy m_voicePolicy;
+    const int m_stealFadeSamples;
+    
+    // Shared reset trigger
+    EventUtils::IsTrigger m_resetTrigger;
+    
+    // Audio buffer and processing
+    float* m_buffer{nullptr};
+    int m_writePos = 0;
+
+    // Grain stream of one tap
+    struct Tap {
+        EventUtils::SchedulerCycle scheduler;
+        GrainReader reader;
+        float* compensationBlock{nullptr};
+        float delayTimePast;
+        bool blockRendered;
+        
+        // Audio rate flags
+        bool isTriggerRateAudioRate;
+        bool isOverlapAudioRate;
+        bool isDelayTimeAudioRate;
+        bool isGrainRateAudioRate;
+    };
+    std::array<Tap, MAX_TAPS> m_taps;
+
+    // Voices, audio buffer and block buffers of all taps, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
+    
+    // Feedback processing filters
+    FilterUtils::OnePoleDirect m_dampingFilter;
+    FilterUtils::OnePoleHz m_dcBlocker;
+ 
+    // Cache for SlopeSignal state
+    float mixPast;
+    float feedbackPast;
+    float dampingPast;
+    
+    // Audio rate flags
+    bool isMixAudioRate;
+    bool isFeedbackAudioRate;
+    bool isDampingAudioRate;
+    bool isFreezeAudioRate;
+    bool isResetAudioRate;
+    
+    enum InputParams {
+        Input,
+        Mix,
+        Feedback,
+        Damping,
+        Freeze,
+        Reset,
+        MaxVoices,
+        VoicePolicy,
+        MaxDelay,
+        TapInputs
     };
-};
\ No newline at end of file
+
+    // Inputs of each tap, following TapInputs in groups of NumTapParams
+    enum TapParams {
+        TriggerRate,
+        Overlap,
+        DelayTime,
+        GrainRate,
+        NumTapParams
+    };
+
+    int tapInput(int tap, TapParams param) const {
+        return TapInputs + tap * NumTapParams + param;
+    }
+};
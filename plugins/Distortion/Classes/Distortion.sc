@@ -1,5 +1,10 @@
-BuchlaFold : UGen {
-	*ar { |input, drive, oversample = 0|
-		^this.multiNew('audio', input, drive, oversample)
+BuchlaFold : MultiOutUGen {
+	*ar { |input, drive, oversample = 0, filter = 0, latency = false|
+		^this.multiNew('audio', input, drive, oversample, filter, latency.asInteger.clip(0, 1))
 	}
-}
\ No newline at end of file
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		^this.initOutputs(1 + inputs.last, rate);  // inputs.last is latency
+	}
+}
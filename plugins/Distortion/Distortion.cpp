@@ -8,7 +8,8 @@ extern InterfaceTable* ft;
 BuchlaFold::BuchlaFold() : 
     m_sampleRate(static_cast<float>(sampleRate())),
     m_oversampleIndex(sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
-    m_osRatio(1 << m_oversampleIndex)
+    m_osRatio(1 << m_oversampleIndex),
+    m_latencyOutput(numOutputs() > 1)
 {
     // Initialize parameter cache
     drivePast = sc_clip(in0(Drive), 0.0f, 10.0f);
@@ -20,13 +21,24 @@ BuchlaFold::BuchlaFold() :
     if (m_oversampleIndex > 0) {
         auto unit = this;
 
-        // Allocate oversampling buffers
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_driveOSBuffer);
+        // Allocate oversampled block buffers and linear-phase filter stages in one block
+        const int osBlockSize = bufferSize() * m_osRatio;
+        const auto filterDesign = OversamplingUtils::resolveFilterDesign(in0(FilterDesign));
+        OversamplingUtils::VariableOversampling::FIRStages* firStages = nullptr;
+        m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+            m_outputOSBuffer = arena.buffer<float>(osBlockSize);
+            m_driveOSBuffer = arena.buffer<float>(osBlockSize);
+            if (filterDesign == OversamplingUtils::FilterDesign::LinearPhase) {
+                firStages = arena.object<OversamplingUtils::VariableOversampling::FIRStages>();
+            }
+        });
+        if (!m_arena.valid()) {
+            return;
+        }
 
         // Setup oversampling filters
-        m_outputOversampling.init(m_osRatio, m_sampleRate, m_outputOSBuffer);
-        m_driveOversampling.init(m_osRatio, m_sampleRate, m_driveOSBuffer);
+        m_outputOversampling.init(m_osRatio, filterDesign, firStages);
+        m_driveOversampling.init(m_osRatio, {!isDriveAudioRate}, {drivePast});
     }
     
     // Set calc function & compute initial sample
@@ -34,8 +46,7 @@ BuchlaFold::BuchlaFold() :
 }
 
 BuchlaFold::~BuchlaFold() {
-    RTFree(mWorld, m_outputOSBuffer);
-    RTFree(mWorld, m_driveOSBuffer);
+    m_arena.free(mWorld);
 }
 
 void BuchlaFold::next(int nSamples) {
@@ -65,32 +76,38 @@ void BuchlaFold::next(int nSamples) {
         for (int i = 0; i < nSamples; ++i) {
             
             // Get current parameter values (audio-rate or interpolated control-rate)
-            float driveVal = isDriveAudioRate ? 
+            m_driveOSBuffer[i] = isDriveAudioRate ? 
                 sc_clip(in(Drive)[i], 0.0f, 10.0f) : 
                 slopedDrive.consume();
+        }
+
+        // Upsample input and parameter values for the whole block (drive is ramped at control rate)
+        const int osSamples = nSamples * m_osRatio;
+        m_outputOversampling.upsampleBlock(input, m_outputOSBuffer, nSamples);
+        m_driveOversampling.upsampleBlock({m_driveOSBuffer}, nSamples);
             
-            // Upsample input and parameter values
-            m_outputOversampling.upsample(input[i]);
-            m_driveOversampling.upsample(driveVal);
+        for (int k = 0; k < osSamples; ++k) {
             
-            for (int k = 0; k < m_osRatio; ++k) {
-                
-                // Clamp upsampled values
-                m_driveOSBuffer[k] = sc_clip(m_driveOSBuffer[k], 0.0f, 10.0f);
-                
-                // Process wavefolder with upsampled parameter values
-                m_outputOSBuffer[k] = m_folder.process(m_outputOSBuffer[k], m_driveOSBuffer[k]);
-            }
+            // Clamp upsampled values
+            float driveVal = sc_clip(m_driveOSBuffer[k], 0.0f, 10.0f);
             
-            // Downsample output
-            output[i] = m_outputOversampling.downsample();
+            // Process wavefolder with upsampled parameter values
+            m_outputOSBuffer[k] = m_folder.process(m_outputOSBuffer[k], driveVal);
         }
+        
+        // Downsample output
+        m_outputOversampling.downsampleBlock(m_outputOSBuffer, output, nSamples);
     }
     
     // Update parameter cache (use last value if audio-rate, otherwise slope value)
     drivePast = isDriveAudioRate ? 
         sc_clip(in(Drive)[nSamples - 1], 0.0f, 10.0f) : 
         slopedDrive.value;
+
+    // Round trip delay of the oversampling filters in samples, for latency compensation
+    if (m_latencyOutput) {
+        std::fill_n(out(Latency), nSamples, static_cast<float>(m_outputOversampling.latency()));
+    }
 }
 
 void Distortion_setup() 
@@ -18,15 +18,17 @@ private:
     const float m_sampleRate;
     const int m_oversampleIndex;
     const int m_osRatio;
+    const bool m_latencyOutput;
     
     // Core processing
     DistortionUtils::BuchlaFold m_folder;
     
     // Oversampling objects
     OversamplingUtils::VariableOversampling m_outputOversampling;
-    OversamplingUtils::VariableOversampling m_driveOversampling;
+    OversamplingUtils::MultiChannelOversampling<1> m_driveOversampling;
     
-    // Stored oversampling state
+    // Stored oversampling state, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
     float* m_outputOSBuffer{nullptr};
     float* m_driveOSBuffer{nullptr};
     
@@ -39,10 +41,13 @@ private:
     enum InputParams { 
         Input, 
         Drive,
-        Oversample
+        Oversample,
+        FilterDesign,
+        LatencyOutput
     };
     
     enum Outputs { 
-        Out 
+        Out,
+        Latency
     };
 };
\ No newline at end of file
@@ -56,16 +56,49 @@ SchedulerBurst {
 	}
 }
 
+// ===== SCHEDULER LIST =====
+
+SchedulerListUGen : MultiOutUGen {
+	*ar { |bufnum, speed = 1, reset = 0, loopLength = 0, numParams = 0|
+		^this.multiNew('audio', bufnum, speed, reset, loopLength, numParams)
+	}
+
+	init { |... theInputs|
+		inputs = theInputs;
+		// inputs[4] is numParams
+		^this.initOutputs(4 + inputs[4], rate);
+	}
+
+	checkInputs {
+		^this.checkValidInputs
+	}
+}
+
+SchedulerList {
+	*ar { |bufnum, speed = 1, reset = 0, loopLength = 0, numParams = 0|
+		var params = numParams.asInteger.clip(0, 16);
+		var events = SchedulerListUGen.ar(bufnum, speed, reset, loopLength, params).asArray;
+		^(
+			trigger: events[0],
+			rate: events[1],
+			subSampleOffset: events[2],
+			phase: events[3],
+			params: if(params > 0) { events[4..params + 3] }
+		);
+	}
+}
+
 // ===== VOICE ALLOCATOR =====
 
 VoiceAllocatorUGen : MultiOutUGen {
-	*ar { |numChannels, trig, rate, subSampleOffset|
-		^this.multiNew('audio', numChannels, trig, rate, subSampleOffset)
+	*ar { |numChannels, trig, rate, subSampleOffset, voicePolicy = 0, voiceStats = 0, packed = 0|
+		^this.multiNew('audio', numChannels, trig, rate, subSampleOffset, voicePolicy, voiceStats, packed)
 	}
 
 	init { arg ... theInputs;
 		inputs = theInputs;
-		^this.initOutputs(inputs[0] * 2, rate);  // inputs[0] is numChannels
+		// inputs[0] is numChannels, inputs[5] is voiceStats, inputs[6] is packed
+		^this.initOutputs((if(inputs[6] > 0) { 3 } { inputs[0] * 2 }) + inputs[5], rate);
 	}
 
 	checkInputs {
@@ -74,11 +107,90 @@ VoiceAllocatorUGen : MultiOutUGen {
 }
 
 VoiceAllocator {
-	*ar { |numChannels, trig, rate, subSampleOffset|
-		var voices = VoiceAllocatorUGen.ar(numChannels, trig, rate, subSampleOffset);
+	*ar { |numChannels, trig, rate, subSampleOffset, voicePolicy = 0, voiceStats = false, packed = false|
+		var stats = voiceStats.asInteger.clip(0, 1);
+		var pack = packed.asInteger.clip(0, 1);
+		var voices = VoiceAllocatorUGen.ar(numChannels, trig, rate, subSampleOffset, voicePolicy, stats, pack);
+		if(pack > 0) {
+			^(
+				trigger: voices[0],
+				voice: voices[1],
+				phase: voices[2],
+				overflow: if(stats > 0) { voices[3] }
+			);
+		};
 		^(
 			phases: voices[0..numChannels - 1],
-			triggers: voices[numChannels..numChannels * 2 - 1]
+			triggers: voices[numChannels..numChannels * 2 - 1],
+			overflow: if(stats > 0) { voices[numChannels * 2] }
+		);
+	}
+}
+
+// ===== VOICE GATE =====
+
+VoiceGateUGen : MultiOutUGen {
+	*ar { |trig, voice, channel, rate, subSampleOffset|
+		^this.multiNew('audio', trig, voice, channel, rate, subSampleOffset)
+	}
+
+	*kr { |trig, voice, channel, rate, subSampleOffset|
+		^this.multiNew('control', trig, voice, channel, rate, subSampleOffset)
+	}
+
+	init { |... theInputs|
+		inputs = theInputs;
+		^this.initOutputs(if(rate == 'audio') { 3 } { 1 }, rate);  // the control rate version only outputs the gate
+	}
+
+	checkInputs {
+		^this.checkValidInputs
+	}
+}
+
+VoiceGate {
+	*ar { |trig, voice, channel, rate, subSampleOffset|
+		var gate = VoiceGateUGen.ar(trig, voice, channel, rate, subSampleOffset);
+		^(
+			phase: gate[0],
+			trigger: gate[1],
+			gate: gate[2]
+		);
+	}
+
+	*kr { |trig, voice, channel, rate, subSampleOffset|
+		^VoiceGateUGen.kr(trig, voice, channel, rate, subSampleOffset)
+	}
+}
+
+// ===== GRAIN CLOCK =====
+
+GrainClockUGen : MultiOutUGen {
+	*ar { |numChannels, triggerRate, overlap = 1, grainFreq = 0, reset = 0, voicePolicy = 0, integrate = 0, accumulate = 0|
+		^this.multiNew('audio', numChannels, triggerRate, overlap, grainFreq, reset, voicePolicy, integrate, accumulate)
+	}
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		// inputs[0] is numChannels, inputs[6] is integrate, inputs[7] is accumulate
+		^this.initOutputs(inputs[0] * (1 + inputs[6] + inputs[7]), rate);
+	}
+
+	checkInputs {
+		^this.checkValidInputs
+	}
+}
+
+GrainClock {
+	*ar { |numChannels, triggerRate, overlap = 1, grainFreq = 0, reset = 0, voicePolicy = 0, integrate = false, accumulate = false|
+		var integ = integrate.asInteger.clip(0, 1);
+		var accum = accumulate.asInteger.clip(0, 1);
+		var clock = GrainClockUGen.ar(numChannels, triggerRate, overlap, grainFreq, reset, voicePolicy, integ, accum).asArray;
+		var accumOffset = numChannels * (1 + integ);
+		^(
+			phases: clock[0..numChannels - 1],
+			grainPhases: if(integ > 0) { clock[numChannels..numChannels * 2 - 1] },
+			counts: if(accum > 0) { clock[accumOffset..accumOffset + numChannels - 1] }
 		);
 	}
 }
@@ -117,4 +229,22 @@ RampDivider : UGen {
 	checkInputs {
 		^this.checkValidInputs
 	}
-}
\ No newline at end of file
+}
+
+// ===== RAMP DIVIDER BANK =====
+
+RampDividerBank : MultiOutUGen {
+	*ar { |phase, ratios = #[1], reset = 0, mode = 1|
+		^this.multiNewList(['audio', phase, reset, mode] ++ ratios.asArray)
+	}
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		// inputs[0..2] are phase, reset and mode, followed by one ratio per output
+		^this.initOutputs(inputs.size - 3, rate);
+	}
+
+	checkInputs {
+		^this.checkValidInputs
+	}
+}
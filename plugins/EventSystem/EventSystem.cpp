@@ -29,6 +29,20 @@ void SchedulerCycle::next(int nSamples) {
     float* rateOut = out(RateLatched);
     float* offsetOut = out(SubSampleOffset);
     float* phaseOut = out(Phase);
+
+    // Control-rate inputs: the wraps of the whole block are computed at once
+    if (!isRateAudioRate && !isResetAudioRate) {
+
+        // A control-rate reset can only fire on the first sample, apply it ahead of the block
+        if (m_resetTrigger.process(in0(Reset))) {
+            m_scheduler.reset();
+        }
+
+        float rate = sc_clip(in0(Rate), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        if (m_scheduler.processBlock(rate, m_sampleRate, nSamples, triggerOut, phaseOut, rateOut, offsetOut)) {
+            return;
+        }
+    }
    
     for (int i = 0; i < nSamples; ++i) {
 
@@ -85,6 +99,21 @@ void SchedulerBurst::next(int nSamples) {
     float* rateOut = out(RateLatched);
     float* offsetOut = out(SubSampleOffset);
     float* phaseOut = out(Phase);
+
+    // Control-rate inputs: the steps of the whole block are computed at once
+    if (!isInitTriggerAudioRate && !isDurationAudioRate && !isCyclesAudioRate) {
+
+        // A control-rate trigger can only fire on the first sample, start the burst ahead of the block
+        if (m_initTrigger.process(in0(InitTrigger))) {
+            m_scheduler.start();
+        }
+
+        float duration = sc_max(in0(Duration), m_sampleDur);
+        int cycles = sc_max(static_cast<int>(in0(Cycles)), 1);
+        if (m_scheduler.processBlock(duration, cycles, m_sampleRate, nSamples, triggerOut, phaseOut, rateOut, offsetOut)) {
+            return;
+        }
+    }
     
     for (int i = 0; i < nSamples; ++i) {
         
@@ -118,23 +147,115 @@ void SchedulerBurst::next(int nSamples) {
     }
 }
 
+// ===== SCHEDULER LIST =====
+
+SchedulerList::SchedulerList() :
+    m_sampleRate(static_cast<float>(sampleRate())),
+    m_numParams(sc_clip(numOutputs() - static_cast<int>(Params), 0, EventUtils::SchedulerList::MAX_PARAMS))
+{
+    m_scheduler.numParams = m_numParams;
+    
+    // Check which inputs are audio-rate
+    isResetAudioRate = isAudioRateIn(Reset);
+    
+    // Set calc function & compute initial sample
+    set_calc_function<SchedulerList, &SchedulerList::next>();
+    
+    // Reset state after priming
+    m_scheduler.reset();
+    m_resetTrigger.reset();
+}
+
+SchedulerList::~SchedulerList() = default;
+
+bool SchedulerList::acquireEvents() {
+    
+    auto table = m_bufUnit.GetTable(this, in0(BufNum), "SchedulerList");
+    if (!table.valid) {
+        return false;
+    }
+    
+    // A new or resized buffer moves the cursor to the current score position
+    const SndBuf* buf = m_bufUnit.m_buf;
+    const EventUtils::EventList events{table.data, buf->frames, sc_max(buf->channels, 1)};
+    if (events.data != m_events.data || events.numEvents != m_events.numEvents || 
+        events.numChannels != m_events.numChannels) {
+        m_events = events;
+        m_scheduler.seek(m_events);
+    }
+    
+    return true;
+}
+
+void SchedulerList::next(int nSamples) {
+    
+    if (!acquireEvents()) {
+        ClearUnitOutputs(this, nSamples);
+        return;
+    }
+    
+    // Output pointers
+    float* triggerOut = out(Trigger);
+    float* rateOut = out(RateLatched);
+    float* offsetOut = out(SubSampleOffset);
+    float* phaseOut = out(Phase);
+    std::array<float*, EventUtils::SchedulerList::MAX_PARAMS> paramOuts;
+    for (int p = 0; p < m_numParams; ++p) {
+        paramOuts[p] = out(Params + p);
+    }
+    
+    // Control-rate parameters, constant for the block
+    float speed = sc_max(in0(Speed), 0.0f);
+    float loopLength = sc_max(in0(LoopLength), 0.0f);
+    
+    // Split the block at audio-rate resets, a control-rate reset applies ahead of the block
+    int start = 0;
+    if (isResetAudioRate) {
+        const float* resetIn = in(Reset);
+        for (int i = 0; i < nSamples; ++i) {
+            if (m_resetTrigger.process(resetIn[i])) {
+                m_scheduler.process(m_events, speed, loopLength, m_sampleRate, start, i,
+                                    triggerOut, rateOut, offsetOut, phaseOut, paramOuts.data());
+                m_scheduler.reset();
+                start = i;
+            }
+        }
+    } else if (m_resetTrigger.process(in0(Reset))) {
+        m_scheduler.reset();
+    }
+    
+    m_scheduler.process(m_events, speed, loopLength, m_sampleRate, start, nSamples,
+                        triggerOut, rateOut, offsetOut, phaseOut, paramOuts.data());
+}
+
 // ===== VOICE ALLOCATOR =====
 
 VoiceAllocator::VoiceAllocator() : 
     m_sampleRate(static_cast<float>(sampleRate())),
-    m_numChannels(sc_clip(static_cast<int>(in0(NumChannels)), 1, MAX_CHANNELS))
+    m_numChannels(sc_clip(static_cast<int>(in0(NumChannels)), 1, MAX_CHANNELS)),
+    m_packedOutput(in0(OutputMode) > 0.5f),
+    m_overflowOutput(static_cast<int>(numOutputs()) > (m_packedOutput ? PackedOverflow : m_numChannels * 2))
 {
+    // Only the requested channels take part in allocation
+    m_allocator.numChannels = m_numChannels;
+    m_allocator.policy = EventUtils::resolveVoicePolicy(in0(VoicePolicy));
+
     // Check which inputs are audio-rate
     isTriggerAudioRate = isAudioRateIn(Trigger);
     isRateAudioRate = isAudioRateIn(Rate);
     isSubSampleOffsetAudioRate = isAudioRateIn(SubSampleOffset);
     
     // Set calc function & compute initial sample
-    set_calc_function<VoiceAllocator, &VoiceAllocator::next>();
+    if (m_packedOutput) {
+        set_calc_function<VoiceAllocator, &VoiceAllocator::nextPacked>();
+    } else {
+        set_calc_function<VoiceAllocator, &VoiceAllocator::next>();
+    }
 
     // Reset state after priming
     m_allocator.reset();
     m_trigger.reset();
+    m_lastVoice = 0;
 }
 
 VoiceAllocator::~VoiceAllocator() = default;
@@ -167,11 +288,270 @@ void VoiceAllocator::next(int nSamples) {
         // Output phases and triggers
         for (int ch = 0; ch < m_numChannels; ++ch) {
             out(ch)[i] = m_allocator.phases[ch];
-            out(m_numChannels + ch)[i] = m_allocator.triggers[ch];
+            out(m_numChannels + ch)[i] = 0.0f;
+        }
+        if (m_allocator.triggered >= 0) {
+            out(m_numChannels + m_allocator.triggered)[i] = 1.0f;
+        }
+        if (m_overflowOutput) {
+            out(m_numChannels * 2)[i] = static_cast<float>(m_allocator.overflowCount);
         }
     }
 }
 
+void VoiceAllocator::nextPacked(int nSamples) {
+
+    // Output pointers
+    float* triggerOut = out(PackedTrigger);
+    float* voiceOut = out(PackedVoice);
+    float* phaseOut = out(PackedPhase);
+
+    for (int i = 0; i < nSamples; ++i) {
+        
+        // Trigger input (audio-rate or control-rate)
+        bool trigger = isTriggerAudioRate ? 
+            m_trigger.process(in(Trigger)[i]) : 
+            m_trigger.process(in0(Trigger));
+        
+        // Get current parameter values (no interpolation - latched per trigger)
+        float rate = isRateAudioRate ? 
+            sc_clip(in(Rate)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
+            sc_clip(in0(Rate), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        
+        float offset = isSubSampleOffsetAudioRate ? 
+            in(SubSampleOffset)[i] : 
+            in0(SubSampleOffset);
+
+        // Process voice allocator
+        int voice = m_allocator.process(
+            trigger, 
+            rate, 
+            offset, 
+            m_sampleRate
+        );
+        if (voice >= 0) {
+            m_lastVoice = voice;
+        }
+       
+        // Output the allocation and the phase of the most recent channel
+        triggerOut[i] = voice >= 0 ? 1.0f : 0.0f;
+        voiceOut[i] = static_cast<float>(m_lastVoice);
+        phaseOut[i] = m_allocator.phases[m_lastVoice];
+        if (m_overflowOutput) {
+            out(PackedOverflow)[i] = static_cast<float>(m_allocator.overflowCount);
+        }
+    }
+}
+
+// ===== VOICE GATE =====
+
+VoiceGate::VoiceGate() : 
+    m_sampleRate(static_cast<float>(fullSampleRate())),
+    m_channel(static_cast<int>(in0(Channel)))
+{
+    // Check which inputs are audio-rate
+    isTriggerAudioRate = isAudioRateIn(Trigger);
+    isVoiceAudioRate = isAudioRateIn(Voice);
+    isRateAudioRate = isAudioRateIn(Rate);
+    isSubSampleOffsetAudioRate = isAudioRateIn(SubSampleOffset);
+    
+    // Set calc function & compute initial sample
+    if (mCalcRate == calc_FullRate) {
+        set_calc_function<VoiceGate, &VoiceGate::next<true>>();
+    } else {
+        set_calc_function<VoiceGate, &VoiceGate::next<false>>();
+    }
+
+    // Reset state after priming
+    m_phase = 0.0;
+    m_slope = 0.0;
+    m_active = false;
+    m_trigger.reset();
+}
+
+VoiceGate::~VoiceGate() = default;
+
+template<bool AudioRate>
+void VoiceGate::next(int nSamples) {
+
+    // At control rate the audio-rate inputs of the whole block are scanned for one gate value
+    const int numSamples = AudioRate ? nSamples : fullBufferSize();
+
+    // Whether the channel is live anywhere in this block
+    bool live = m_active;
+
+    for (int i = 0; i < numSamples; ++i) {
+        
+        // Trigger input (audio-rate or control-rate)
+        bool trigger = isTriggerAudioRate ? 
+            m_trigger.process(in(Trigger)[i]) : 
+            m_trigger.process(in0(Trigger));
+        
+        // Get current parameter values (no interpolation - latched per trigger)
+        int voice = isVoiceAudioRate ? 
+            static_cast<int>(in(Voice)[i]) : 
+            static_cast<int>(in0(Voice));
+        
+        float rate = isRateAudioRate ? 
+            sc_clip(in(Rate)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
+            sc_clip(in0(Rate), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        
+        float offset = isSubSampleOffsetAudioRate ? 
+            in(SubSampleOffset)[i] : 
+            in0(SubSampleOffset);
+
+        // 1. Free the channel once its phase completes, otherwise output and increment
+        float phase = 0.0f;
+        if (m_active) {
+            if (m_phase >= 1.0) {
+                m_active = false;
+                m_phase = 0.0;
+            } else {
+                phase = static_cast<float>(m_phase);
+                m_phase += m_slope;
+            }
+        }
+
+        // 2. Restart the phase if the trigger was allocated to this channel, same as the allocator
+        bool triggered = trigger && voice == m_channel;
+        if (triggered) {
+            m_slope = static_cast<double>(rate) / m_sampleRate;
+            m_phase = m_slope * offset;
+            m_active = true;
+            live = true;
+            
+            // Output current phase and increment
+            phase = m_phase < 1.0 ? static_cast<float>(m_phase) : 0.0f;
+            m_phase += m_slope;
+        }
+
+        // Output values
+        if constexpr (AudioRate) {
+            out(PhaseOut)[i] = phase;
+            out(TriggerOut)[i] = triggered ? 1.0f : 0.0f;
+        }
+    }
+
+    // Block gate, so that a paused branch is resumed for the whole block its channel starts in
+    if constexpr (AudioRate) {
+        std::fill_n(out(GateOut), nSamples, live ? 1.0f : 0.0f);
+    } else {
+        out0(0) = live ? 1.0f : 0.0f;
+    }
+}
+
+// ===== GRAIN CLOCK =====
+
+GrainClock::GrainClock() : 
+    m_sampleRate(static_cast<float>(sampleRate())),
+    m_numChannels(sc_clip(static_cast<int>(in0(NumChannels)), 1, MAX_CHANNELS)),
+    m_integratorOutput(in0(Integrate) > 0.5f),
+    m_accumulatorOutput(in0(Accumulate) > 0.5f)
+{
+    // Only the requested channels take part in allocation
+    m_allocator.numChannels = m_numChannels;
+    m_allocator.policy = EventUtils::resolveVoicePolicy(in0(VoicePolicy));
+
+    // Initialize parameter cache
+    grainFreqPast = sc_clip(in0(GrainFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+
+    // Check which inputs are audio-rate
+    isTriggerRateAudioRate = isAudioRateIn(TriggerRate);
+    isOverlapAudioRate = isAudioRateIn(Overlap);
+    isGrainFreqAudioRate = isAudioRateIn(GrainFreq);
+    isResetAudioRate = isAudioRateIn(Reset);
+    
+    // Set calc function & compute initial sample
+    set_calc_function<GrainClock, &GrainClock::next>();
+
+    // Reset state after priming
+    m_scheduler.reset();
+    m_allocator.reset();
+    for (int ch = 0; ch < m_numChannels; ++ch) {
+        m_integrators[ch].reset();
+        m_accumulators[ch].reset();
+    }
+    m_resetTrigger.reset();
+}
+
+GrainClock::~GrainClock() = default;
+
+void GrainClock::next(int nSamples) {
+
+    // Control-rate parameters with smooth interpolation
+    auto slopedGrainFreq = makeSlope(sc_clip(in0(GrainFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f), grainFreqPast);
+
+    // Integrator phases follow the window phases, accumulator counts follow the enabled outputs before them
+    const int integratorOffset = m_numChannels;
+    const int accumulatorOffset = m_integratorOutput ? m_numChannels * 2 : m_numChannels;
+
+    for (int i = 0; i < nSamples; ++i) {
+
+        // Get current parameter values (no interpolation - latched per trigger)
+        float triggerRate = isTriggerRateAudioRate ? 
+            sc_clip(in(TriggerRate)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
+            sc_clip(in0(TriggerRate), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+
+        float overlap = isOverlapAudioRate ? 
+            sc_max(in(Overlap)[i], 0.001f) : 
+            sc_max(in0(Overlap), 0.001f);
+
+        // Get current parameter values (audio-rate or interpolated control-rate)
+        float grainFreq = isGrainFreqAudioRate ? 
+            sc_clip(in(GrainFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
+            slopedGrainFreq.consume();
+        
+        // Trigger input (audio-rate or control-rate)
+        bool reset = isResetAudioRate ? 
+            m_resetTrigger.process(in(Reset)[i]) : 
+            m_resetTrigger.process(in0(Reset));
+
+        // 1. Process event scheduler
+        auto event = m_scheduler.process(
+            triggerRate, 
+            reset, 
+            m_sampleRate
+        );
+
+        // 2. Process voice allocator with the rate scaled by overlap
+        float rateScaled = sc_clip(event.rate / overlap, m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        int voice = m_allocator.process(
+            event.trigger, 
+            rateScaled, 
+            event.subSampleOffset, 
+            m_sampleRate
+        );
+
+        // 3. Output phases and the per-voice ramps restarted by their channel's trigger
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            out(ch)[i] = m_allocator.phases[ch];
+        }
+        if (m_integratorOutput) {
+            for (int ch = 0; ch < m_numChannels; ++ch) {
+                out(integratorOffset + ch)[i] = m_integrators[ch].process(
+                    ch == voice, 
+                    grainFreq, 
+                    event.subSampleOffset, 
+                    m_sampleRate
+                );
+            }
+        }
+        if (m_accumulatorOutput) {
+            for (int ch = 0; ch < m_numChannels; ++ch) {
+                out(accumulatorOffset + ch)[i] = m_accumulators[ch].process(
+                    ch == voice, 
+                    event.subSampleOffset
+                );
+            }
+        }
+    }
+    
+    // Update parameter cache (use last value if audio-rate, otherwise slope value)
+    grainFreqPast = isGrainFreqAudioRate ? 
+        sc_clip(in(GrainFreq)[nSamples - 1], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
+        slopedGrainFreq.value;
+}
+
 // ===== RAMP INTEGRATOR =====
 
 RampIntegrator::RampIntegrator() : 
@@ -342,12 +722,102 @@ void RampDivider::next(int nSamples) {
         slopedRatio.value;
 }
 
+// ===== RAMP DIVIDER BANK =====
+
+RampDividerBank::RampDividerBank() :
+    m_numDividers(sc_clip(sc_min(numOutputs(), numInputs() - static_cast<int>(Ratios)), 1, MAX_DIVIDERS))
+{
+    m_dividers.numDividers = m_numDividers;
+
+    // Initialize parameter cache and check which inputs are audio-rate
+    for (int k = 0; k < m_numDividers; ++k) {
+        ratioPast[k] = in0(Ratios + k);
+        isRatioAudioRate[k] = isAudioRateIn(Ratios + k);
+    }
+    isResetAudioRate = isAudioRateIn(Reset);
+    
+    // Set calc function & compute initial sample
+    switch (sc_clip(static_cast<int>(in0(Mode)), 0, 2)) {
+        case 0: set_calc_function<RampDividerBank, &RampDividerBank::next<0>>(); break;
+        case 1: set_calc_function<RampDividerBank, &RampDividerBank::next<1>>(); break;
+        case 2: set_calc_function<RampDividerBank, &RampDividerBank::next<2>>(); break;
+    }
+    
+    // Reset state after priming
+    m_dividers.reset();
+    m_resetTrigger.reset();
+}
+
+RampDividerBank::~RampDividerBank() = default;
+
+template<int Mode>
+void RampDividerBank::next(int nSamples) {
+    
+    // Audio-rate input
+    const float* phaseIn = in(Phase);
+    
+    // Control-rate ratios with smooth interpolation, one slope per ratio
+    std::array<float, MAX_DIVIDERS> ratioSlope;
+    for (int k = 0; k < m_numDividers; ++k) {
+        ratioSlope[k] = isRatioAudioRate[k] ? 0.0f : calcSlope(in0(Ratios + k), ratioPast[k]);
+    }
+    
+    // Ratios and divided phases of the current sample, one entry per divider
+    std::array<float, MAX_DIVIDERS> ratios;
+    std::array<float, MAX_DIVIDERS> phases;
+    
+    for (int i = 0; i < nSamples; ++i) {
+        
+        // Wrap phase between 0 and 1
+        double phase = sc_frac(static_cast<double>(phaseIn[i]));
+        
+        // Get current ratio values (audio-rate or interpolated control-rate)
+        for (int k = 0; k < m_numDividers; ++k) {
+            if (isRatioAudioRate[k]) {
+                ratios[k] = in(Ratios + k)[i];
+            } else {
+                ratios[k] = ratioPast[k];
+                ratioPast[k] += ratioSlope[k];
+            }
+        }
+        
+        // Trigger input (audio-rate or control-rate)
+        bool reset = isResetAudioRate ? 
+            m_resetTrigger.process(in(Reset)[i]) : 
+            m_resetTrigger.process(in0(Reset));
+        
+        // Process all dividers at once
+        if constexpr (Mode == 0) {
+            m_dividers.processSimple(phase, ratios.data(), reset, phases.data());
+        } else if constexpr (Mode == 1) {
+            m_dividers.processGrid(phase, ratios.data(), reset, phases.data());
+        } else {
+            m_dividers.processOffset(phase, ratios.data(), reset, phases.data());
+        }
+        
+        for (int k = 0; k < m_numDividers; ++k) {
+            out(k)[i] = phases[k];
+        }
+    }
+    
+    // Update parameter cache for audio-rate ratios (control-rate ratios were advanced per sample)
+    for (int k = 0; k < m_numDividers; ++k) {
+        if (isRatioAudioRate[k]) {
+            ratioPast[k] = in(Ratios + k)[nSamples - 1];
+        }
+    }
+}
+
 void EventSystem_setup() 
 {
     registerUnit<SchedulerCycle>(ft, "SchedulerCycleUGen", false);
     registerUnit<SchedulerBurst>(ft, "SchedulerBurstUGen", false);
+    registerUnit<SchedulerList>(ft, "SchedulerListUGen", false);
     registerUnit<VoiceAllocator>(ft, "VoiceAllocatorUGen", false);
+    registerUnit<VoiceGate>(ft, "VoiceGateUGen", false);
+    registerUnit<GrainClock>(ft, "GrainClockUGen", false);
     registerUnit<RampIntegrator>(ft, "RampIntegrator", false);
     registerUnit<RampAccumulator>(ft, "RampAccumulator", false);
     registerUnit<RampDivider>(ft, "RampDivider", false);
+    registerUnit<RampDividerBank>(ft, "RampDividerBank", false);
 }
\ No newline at end of file
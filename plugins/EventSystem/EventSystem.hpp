@@ -2,6 +2,7 @@
 #include "SC_PlugIn.hpp"
 #include "Utils.hpp"
 #include "EventUtils.hpp"
+#include "PluginUtils.hpp"
 
 // ===== SCHEDULER CYCLE =====
 
@@ -74,6 +75,47 @@ private:
     };
 };
 
+// ===== SCHEDULER LIST =====
+
+class SchedulerList : public SCUnit {
+public:
+    SchedulerList();
+    ~SchedulerList();
+
+private:
+    void next(int nSamples);
+    bool acquireEvents();
+    
+    // Constants cached at construction
+    const float m_sampleRate;
+    const int m_numParams;
+    
+    // Core processing
+    EventUtils::SchedulerList m_scheduler;
+    EventUtils::EventList m_events;
+    EventUtils::IsTrigger m_resetTrigger;
+    PluginUtils::BufUnit m_bufUnit;
+    
+    // Audio rate flags
+    bool isResetAudioRate;
+    
+    enum InputParams {
+        BufNum,
+        Speed,
+        Reset,
+        LoopLength,
+        NumParams
+    };
+    
+    enum Outputs {
+        Trigger,
+        RateLatched,
+        SubSampleOffset,
+        Phase,
+        Params
+    };
+};
+
 // ===== VOICE ALLOCATOR =====
 
 class VoiceAllocator : public SCUnit {
@@ -83,6 +125,7 @@ public:
 
 private:
     void next(int nSamples);
+    void nextPacked(int nSamples);
    
     // Constants
     static constexpr int MAX_CHANNELS = 64;
@@ -90,11 +133,16 @@ private:
     // Constants cached at construction
     const float m_sampleRate;
     const int m_numChannels;
+    const bool m_packedOutput;
+    const bool m_overflowOutput;
     
     // Core processing
     EventUtils::VoiceAllocator<MAX_CHANNELS> m_allocator;
     EventUtils::IsTrigger m_trigger;
     
+    // Most recently allocated channel, reported in packed mode
+    int m_lastVoice = 0;
+    
     // Audio rate flags
     bool isTriggerAudioRate;
     bool isRateAudioRate;
@@ -104,10 +152,114 @@ private:
         NumChannels,
         Trigger,
         Rate,
+        SubSampleOffset,
+        VoicePolicy,
+        VoiceStats,
+        OutputMode
+    };
+   
+    // Outputs: numChannels phases and triggers, optionally followed by the overflow count
+    // Output indices are calculated dynamically based on m_numChannels
+    
+    // Packed outputs: one trigger, voice index and phase stream for all channels
+    enum PackedOutputs {
+        PackedTrigger,
+        PackedVoice,
+        PackedPhase,
+        PackedOverflow
+    };
+};
+
+// ===== VOICE GATE =====
+
+class VoiceGate : public SCUnit {
+public:
+    VoiceGate();
+    ~VoiceGate();
+
+private:
+    template<bool AudioRate>
+    void next(int nSamples);
+   
+    // Constants cached at construction
+    const float m_sampleRate;
+    const int m_channel;
+   
+    // Phase of the channel, restarted by each trigger allocated to it
+    double m_phase{0.0};
+    double m_slope{0.0};
+    bool m_active{false};
+    EventUtils::IsTrigger m_trigger;
+    
+    // Audio rate flags
+    bool isTriggerAudioRate;
+    bool isVoiceAudioRate;
+    bool isRateAudioRate;
+    bool isSubSampleOffsetAudioRate;
+   
+    enum InputParams {
+        Trigger,
+        Voice,
+        Channel,
+        Rate,
         SubSampleOffset
     };
    
-    // Outputs: numChannels phases and triggers
+    // At control rate the block gate is the only output
+    enum Outputs {
+        PhaseOut,
+        TriggerOut,
+        GateOut
+    };
+};
+
+// ===== GRAIN CLOCK =====
+
+class GrainClock : public SCUnit {
+public:
+    GrainClock();
+    ~GrainClock();
+
+private:
+    void next(int nSamples);
+   
+    // Constants
+    static constexpr int MAX_CHANNELS = 64;
+
+    // Constants cached at construction
+    const float m_sampleRate;
+    const int m_numChannels;
+    const bool m_integratorOutput;
+    const bool m_accumulatorOutput;
+    
+    // Core processing, scheduler, allocator and per-voice ramps in one pass
+    EventUtils::SchedulerCycle m_scheduler;
+    EventUtils::VoiceAllocator<MAX_CHANNELS> m_allocator;
+    std::array<EventUtils::RampIntegrator, MAX_CHANNELS> m_integrators;
+    std::array<EventUtils::RampAccumulator, MAX_CHANNELS> m_accumulators;
+    EventUtils::IsTrigger m_resetTrigger;
+    
+    // Cache for SlopeSignal state
+    float grainFreqPast;
+    
+    // Audio rate flags
+    bool isTriggerRateAudioRate;
+    bool isOverlapAudioRate;
+    bool isGrainFreqAudioRate;
+    bool isResetAudioRate;
+   
+    enum InputParams {
+        NumChannels,
+        TriggerRate,
+        Overlap,
+        GrainFreq,
+        Reset,
+        VoicePolicy,
+        Integrate,
+        Accumulate
+    };
+   
+    // Outputs: numChannels phases, optionally followed by numChannels integrator phases and numChannels accumulator counts
     // Output indices are calculated dynamically based on m_numChannels
 };
 
@@ -211,4 +363,42 @@ private:
     enum Outputs {
         PhaseOut
     };
-};
\ No newline at end of file
+};
+
+// ===== RAMP DIVIDER BANK =====
+
+class RampDividerBank : public SCUnit {
+public:
+    RampDividerBank();
+    ~RampDividerBank();
+    
+private:
+    template<int Mode>
+    void next(int nSamples);
+    
+    // Constants
+    static constexpr int MAX_DIVIDERS = 32;
+
+    // Constants cached at construction
+    const int m_numDividers;
+
+    // Core processing, one shared slope and wrap detection for all ratios
+    EventUtils::RampDividerBank<MAX_DIVIDERS> m_dividers;
+    EventUtils::IsTrigger m_resetTrigger;
+    
+    // Cache for SlopeSignal state
+    std::array<float, MAX_DIVIDERS> ratioPast;
+    
+    // Audio rate flags
+    std::array<bool, MAX_DIVIDERS> isRatioAudioRate;
+    bool isResetAudioRate;
+    
+    enum InputParams {
+        Phase,
+        Reset,
+        Mode,
+        Ratios
+    };
+    
+    // Outputs: one divided phase per ratio, ratios are the trailing inputs starting at Ratios
+};
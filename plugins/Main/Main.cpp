@@ -14,6 +14,11 @@ void UnitShapers_setup();
 void UnitSteps_setup();
 void UnitWindows_setup();
 
+// Plugin commands
+void cmdPrepareWavetable(World* world, void* inUserData, struct sc_msg_iter* args, void* replyAddr);
+void cmdReleaseWavetable(World* world, void* inUserData, struct sc_msg_iter* args, void* replyAddr);
+void releaseWavetables();
+
 PluginLoad(GrainUtils) {
     ft = inTable;
     Delays_setup();
@@ -26,4 +31,11 @@ PluginLoad(GrainUtils) {
     UnitShapers_setup();
     UnitSteps_setup();
     UnitWindows_setup();
+
+    DefinePlugInCmd("prepareWavetable", cmdPrepareWavetable, nullptr);
+    DefinePlugInCmd("releaseWavetable", cmdReleaseWavetable, nullptr);
+}
+
+PluginUnload(GrainUtils) {
+    releaseWavetables();
 }
\ No newline at end of file
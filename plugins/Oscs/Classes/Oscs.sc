@@ -5,7 +5,7 @@ DualOscOS : MultiOutUGen {
 		  bufnumB, phaseB, numCyclesB = 1, cyclePosB = 0,
 		  pmIndexA = 0, pmIndexB = 0,
 		  pmFilterRatioA = 1, pmFilterRatioB = 1,
-		  oversample = 0|
+		  oversample = 0, interp = 2, filter = 0, latency = false|
 
 		// Validate buffers
 		if(bufnumA.isNil) { Error("DualOscOS: Invalid buffer A").throw };
@@ -15,36 +15,44 @@ DualOscOS : MultiOutUGen {
 			bufnumA, phaseA, numCyclesA, cyclePosA,
 			bufnumB, phaseB, numCyclesB, cyclePosB,
 			pmIndexA, pmIndexB, pmFilterRatioA, pmFilterRatioB,
-			oversample)
+			oversample, interp, filter, latency.asInteger.clip(0, 1))
 	}
 
 	init { arg ... theInputs;
 		inputs = theInputs;
-		^this.initOutputs(2, rate);
+		^this.initOutputs(2 + inputs.last, rate);  // inputs.last is latency
 	}
 }
 
 // ===== SINGLE WAVETABLE OSCILLATOR =====
 
-SingleOscOS : UGen {
-	*ar { |bufnum, phase, numCycles = 1, cyclePos = 0, oversample = 0|
+SingleOscOS : MultiOutUGen {
+	*ar { |bufnum, phase, numCycles = 1, cyclePos = 0, oversample = 0, interp = 2,
+		  filter = 0, latency = false|
 
 		// Validate buffer
 		if(bufnum.isNil) { Error("SingleOscOS: Invalid buffer").throw };
 
-		^this.multiNew('audio', bufnum, phase, numCycles, cyclePos, oversample)
+		^this.multiNew('audio', bufnum, phase, numCycles, cyclePos, oversample, interp,
+			filter, latency.asInteger.clip(0, 1))
+	}
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		^this.initOutputs(1 + inputs.last, rate);  // inputs.last is latency
 	}
 }
 
 // ===== PULSAR OSCILLATOR =====
 
-PulsarOS : UGen {
+PulsarOS : MultiOutUGen {
 	*ar { |trig, triggerFreq, subSampleOffset = 0,
 		  oscFreq = 440, modFreq = 0, modIndex = 0,
 		  oscBuffer, oscNumCycles = 1, oscCyclePos = 0,
 		  envBuffer, envNumCycles = 1, envCyclePos = 0,
 		  modBuffer, modNumCycles = 1, modCyclePos = 0,
-		  oversample = 0|
+		  oversample = 0, interp = 2, maxVoices = 16,
+		  voicePolicy = 0, voiceStats = false|
 
 		if(oscBuffer.isNil) { Error("PulsarOS: Invalid osc buffer").throw };
 		if(envBuffer.isNil) { Error("PulsarOS: Invalid env buffer").throw };
@@ -56,13 +64,19 @@ PulsarOS : UGen {
 			oscBuffer, oscNumCycles, oscCyclePos,
 			envBuffer, envNumCycles, envCyclePos,
 			modBuffer, modNumCycles, modCyclePos,
-			oversample)
+			oversample, interp, maxVoices,
+			voicePolicy, voiceStats.asInteger.clip(0, 1))
+	}
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		^this.initOutputs(1 + inputs.last, rate);  // inputs.last is voiceStats
 	}
 }
 
 // ===== DUAL PULSAR OSCILLATOR =====
 
-DualPulsarOS : UGen {
+DualPulsarOS : MultiOutUGen {
 	*ar { |trig, triggerFreq, subSampleOffset = 0,
 		  oscFreq = 440, modFreq = 440,
 		  pmIndexOsc = 0, pmIndexMod = 0,
@@ -71,7 +85,8 @@ DualPulsarOS : UGen {
 		  oscBuffer, oscNumCycles = 1, oscCyclePos = 0,
 		  modBuffer, modNumCycles = 1, modCyclePos = 0,
 		  skew = 0.5, index = 0,
-		  oversample = 0|
+		  oversample = 0, interp = 2, maxVoices = 16,
+		  voicePolicy = 0, voiceStats = false|
 
 		if(oscBuffer.isNil) { Error("DualPulsarOS: Invalid osc buffer").throw };
 		if(modBuffer.isNil) { Error("DualPulsarOS: Invalid mod buffer").throw };
@@ -85,6 +100,24 @@ DualPulsarOS : UGen {
 			oscBuffer, oscNumCycles, oscCyclePos,
 			modBuffer, modNumCycles, modCyclePos,
 			skew, index,
-			oversample)
+			oversample, interp, maxVoices,
+			voicePolicy, voiceStats.asInteger.clip(0, 1))
+	}
+
+	init { arg ... theInputs;
+		inputs = theInputs;
+		^this.initOutputs(1 + inputs.last, rate);  // inputs.last is voiceStats
+	}
+}
+
+// ===== WAVETABLE PREPARATION =====
+
++ Buffer {
+	prepareWavetable { |numCycles = 1, completionMessage|
+		server.listSendMsg(["/cmd", "prepareWavetable", bufnum, numCycles, completionMessage.value(this)])
+	}
+
+	releaseWavetable { |completionMessage|
+		server.listSendMsg(["/cmd", "releaseWavetable", bufnum, completionMessage.value(this)])
 	}
 }
@@ -1,5 +1,6 @@
 #include "Oscs.hpp"
 #include "SC_PlugIn.hpp"
+#include <new>
 
 extern InterfaceTable* ft;
 
@@ -7,7 +8,11 @@ extern InterfaceTable* ft;
 
 SingleOscOS::SingleOscOS() : 
     m_sampleRate(static_cast<float>(sampleRate())),
-    m_oversampleIndex(sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
+    m_autoOversample(OversamplingUtils::isAutoOversample(in0(Oversample))),
+    m_latencyOutput(numOutputs() > 1),
+    m_oversampleIndex(m_autoOversample ?
+        OversamplingUtils::MAX_OVERSAMPLE_INDEX :
+        sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
     m_osRatio(1 << m_oversampleIndex)
 {
     // Initialize parameter cache
@@ -20,24 +25,67 @@ SingleOscOS::SingleOscOS() :
     if (m_oversampleIndex > 0) {
         auto unit = this;
 
-        // Allocate oversampling buffers
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_cyclePosOSBuffer);
+        // Allocate oversampled block buffers, base-rate phase state and linear-phase filter
+        // stages in one block
+        const int osBlockSize = bufferSize() * m_osRatio;
+        const auto filterDesign = OversamplingUtils::resolveFilterDesign(in0(FilterDesign));
+        OversamplingUtils::VariableOversampling::FIRStages* firStages = nullptr;
+        m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+            m_outputOSBuffer = arena.buffer<float>(osBlockSize);
+            m_cyclePosOSBuffer = arena.buffer<float>(osBlockSize);
+            m_phaseBlock = arena.buffer<float>(bufferSize());
+            m_slopeBlock = arena.buffer<float>(bufferSize());
+            if (filterDesign == OversamplingUtils::FilterDesign::LinearPhase) {
+                firStages = arena.object<OversamplingUtils::VariableOversampling::FIRStages>();
+            }
+        });
+        if (!m_arena.valid()) {
+            return;
+        }
 
         // Setup oversampling filters
-        m_outputOversampling.init(m_osRatio, m_sampleRate, m_outputOSBuffer);
-        m_cyclePosOversampling.init(m_osRatio, m_sampleRate, m_cyclePosOSBuffer);
+        m_outputOversampling.init(m_osRatio, filterDesign, firStages);
+        m_paramOversampling.init(m_osRatio, {!isCyclePosAudioRate}, {cyclePosPast});
     }
     
-    // Set calc function & compute initial sample
-    set_calc_function<SingleOscOS, &SingleOscOS::next>();
+    // Resolve interpolation quality and input rates into calc function & compute initial sample
+    switch (OscUtils::resolveInterpQuality(in0(Interp))) {
+        case OscUtils::InterpLinear:
+            setCalcFunction<OscUtils::LinearInterp>();
+            break;
+        case OscUtils::InterpCubic:
+            setCalcFunction<OscUtils::CubicInterp>();
+            break;
+        case OscUtils::InterpSinc16:
+            setCalcFunction<OscUtils::SincInterp<16>>();
+            break;
+        case OscUtils::InterpSinc32:
+            setCalcFunction<OscUtils::SincInterp<32>>();
+            break;
+        default:
+            setCalcFunction<OscUtils::SincInterp<8>>();
+            break;
+    }
 }
 
 SingleOscOS::~SingleOscOS() {
-    RTFree(mWorld, m_outputOSBuffer);
-    RTFree(mWorld, m_cyclePosOSBuffer);
+    m_arena.free(mWorld);
+}
+
+template<typename Interpolator>
+void SingleOscOS::setCalcFunction() {
+
+    // Control-rate instances skip all per-sample rate checks
+    const bool audioRateInputs = isCyclePosAudioRate;
+
+    if (audioRateInputs) {
+        set_calc_function<SingleOscOS, &SingleOscOS::next<Interpolator, true>>();
+    } else {
+        set_calc_function<SingleOscOS, &SingleOscOS::next<Interpolator, false>>();
+    }
 }
 
+template<typename Interpolator, bool AudioRateInputs>
 void SingleOscOS::next(int nSamples) {
     
     // Audio-rate input
@@ -54,16 +102,13 @@ void SingleOscOS::next(int nSamples) {
     float* output = out(Out);
     
     // Get wavetable data
-    auto oscTable = m_oscBufUnit.GetTable(this, bufNum, "SingleOscOS");
+    auto oscTable = m_oscBufUnit.GetTable(this, bufNum, numCycles, "SingleOscOS");
     if (!oscTable.valid) { 
         ClearUnitOutputs(this, nSamples); 
         return; 
     }
     
-    // Calculate samples per cycle
-    int cycleSamples = oscTable.size / numCycles;
-    
-    if (m_oversampleIndex == 0) {
+    if (m_oversampleIndex == 0 && !m_autoOversample) {
 
         for (int i = 0; i < nSamples; ++i) {
             
@@ -71,96 +116,109 @@ void SingleOscOS::next(int nSamples) {
             float phase = sc_frac(phaseIn[i]);
             
             // Get current parameter values (audio-rate or interpolated control-rate)
-            float cyclePosVal = isCyclePosAudioRate ? 
+            float cyclePosVal = (AudioRateInputs && isCyclePosAudioRate) ? 
                 sc_clip(in(CyclePos)[i], 0.0f, 1.0f) : 
                 slopedCyclePos.consume();
             
             // Calculate slope
             float slope = static_cast<float>(m_rampToSlope.process(static_cast<double>(phase)));
             
-            // Calculate mipmap parameters (use ceil for no oversampling)
-            float rangeSize = static_cast<float>(cycleSamples);
-            float samplesPerFrame = std::abs(slope) * rangeSize;
-            float octave = sc_max(0.0f, sc_log2(samplesPerFrame));
-            int layer = static_cast<int>(sc_ceil(octave));
-
-            // Calculate spacings for adjacent mipmap levels
-            int spacing1 = 1 << layer;
-            int spacing2 = spacing1 << 1;
-            float crossfade = sc_frac(octave);
+            // Calculate mipmap level and crossfade (use ceil for no oversampling)
+            const OscUtils::MipmapLevel level = OscUtils::mipmapLevel(slope, oscTable.cycleSamples, false);
             
             // Process wavetable oscillator
-            output[i] = OscUtils::wavetableOsc(
-                phase, oscTable.data, 
-                cycleSamples, numCycles, cyclePosVal, 
-                spacing1, spacing2, crossfade
+            output[i] = OscUtils::wavetableOsc<Interpolator>(
+                phase, oscTable, cyclePosVal, 
+                level.layer, level.crossfade
             );
         }
     } else {
 
+        float maxSlope = 0.0f;
+
         for (int i = 0; i < nSamples; ++i) {
             
             // Wrap phase between 0 and 1
             float phase = sc_frac(phaseIn[i]);
             
             // Get current parameter values (audio-rate or interpolated control-rate)
-            float cyclePosVal = isCyclePosAudioRate ? 
+            m_cyclePosOSBuffer[i] = (AudioRateInputs && isCyclePosAudioRate) ? 
                 sc_clip(in(CyclePos)[i], 0.0f, 1.0f) : 
                 slopedCyclePos.consume();
             
             // Calculate slope
-            float slope = static_cast<float>(m_rampToSlope.process(static_cast<double>(phase)));
-            
-            // Calculate mipmap parameters (use floor for oversampling)
-            float rangeSize = static_cast<float>(cycleSamples);
-            float samplesPerFrame = std::abs(slope) * rangeSize;
-            float octave = sc_max(0.0f, sc_log2(samplesPerFrame));
-            int layer = static_cast<int>(sc_floor(octave));
+            m_phaseBlock[i] = phase;
+            m_slopeBlock[i] = static_cast<float>(m_rampToSlope.process(static_cast<double>(phase)));
+            maxSlope = sc_max(maxSlope, std::abs(m_slopeBlock[i]));
+        }
+
+        // Pick this block's ratio from the fastest slope
+        if (m_autoOversample) {
+            setOversampleIndex(m_adaptiveRatio.process(maxSlope, 0.0f));
+        }
+        
+        // Upsample parameter values for the whole block (ramped if control-rate)
+        m_paramOversampling.upsampleBlock({m_cyclePosOSBuffer}, nSamples);
+
+        for (int i = 0; i < nSamples; ++i) {
             
-            // Calculate spacings for adjacent mipmap levels
-            int spacing1 = 1 << layer;
-            int spacing2 = spacing1 << 1;
-            float crossfade = sc_frac(octave);
+            float phase = m_phaseBlock[i];
+            float slope = m_slopeBlock[i];
             
-            // Upsample parameter values
-            m_cyclePosOversampling.upsample(cyclePosVal);
+            // Calculate mipmap level and crossfade (use floor for oversampling, ceil otherwise)
+            const OscUtils::MipmapLevel level = OscUtils::mipmapLevel(slope, oscTable.cycleSamples, m_osRatio > 1);
 
             // Initialize phase and slope for oversampling
             float osSlope = slope / static_cast<float>(m_osRatio);
             float osPhase = phase - slope;
             
+            const float* cyclePosOS = m_cyclePosOSBuffer + i * m_osRatio;
+            float* outputOS = m_outputOSBuffer + i * m_osRatio;
+            
             for (int k = 0; k < m_osRatio; k++) {
                 
-                // Clamp upsampled values
-                m_cyclePosOSBuffer[k] = sc_clip(m_cyclePosOSBuffer[k], 0.0f, 1.0f);
-                
                 // Increment oversampled phase
                 osPhase += osSlope;
                 
-                // Process wavetable oscillator with upsampled parameter values
-                m_outputOSBuffer[k] = OscUtils::wavetableOsc(
-                    sc_frac(osPhase), oscTable.data, 
-                    cycleSamples, numCycles, m_cyclePosOSBuffer[k], 
-                    spacing1, spacing2, crossfade
+                // Process wavetable oscillator with clamped upsampled parameter values
+                outputOS[k] = OscUtils::wavetableOsc<Interpolator>(
+                    sc_frac(osPhase), oscTable, sc_clip(cyclePosOS[k], 0.0f, 1.0f), 
+                    level.layer, level.crossfade
                 );
             }
-            
-            // Downsample output
-            output[i] = m_outputOversampling.downsample();
         }
+        
+        // Downsample output for the whole block
+        m_outputOversampling.downsampleBlock(m_outputOSBuffer, output, nSamples);
     }
     
     // Update parameter cache (use last value if audio-rate, otherwise slope value)
     cyclePosPast = isCyclePosAudioRate ? 
         sc_clip(in(CyclePos)[nSamples - 1], 0.0f, 1.0f) : 
         slopedCyclePos.value;
+
+    // Delay of the decimation filters in samples, glides to the new ratio in auto mode
+    if (m_latencyOutput) {
+        m_outputOversampling.downsampleLatencyBlock(out(Latency), nSamples);
+    }
+}
+
+void SingleOscOS::setOversampleIndex(int index) {
+    m_oversampleIndex = index;
+    m_osRatio = 1 << index;
+    m_outputOversampling.setRatio(m_osRatio);
+    m_paramOversampling.setRatio(m_osRatio);
 }
 
 // ===== DUAL WAVETABLE OSCILLATOR =====
 
 DualOscOS::DualOscOS() : 
     m_sampleRate(static_cast<float>(sampleRate())),
-    m_oversampleIndex(sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
+    m_autoOversample(OversamplingUtils::isAutoOversample(in0(Oversample))),
+    m_latencyOutput(numOutputs() > 2),
+    m_oversampleIndex(m_autoOversample ?
+        OversamplingUtils::MAX_OVERSAMPLE_INDEX :
+        sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
     m_osRatio(1 << m_oversampleIndex)
 {
     // Initialize parameter cache
@@ -183,42 +241,91 @@ DualOscOS::DualOscOS() :
     if (m_oversampleIndex > 0) {
         auto unit = this;
 
-        // Allocate oversampling buffers
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBufferA);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBufferB);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_cyclePosAOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_cyclePosBOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_pmIndexAOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_pmIndexBOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_pmFilterRatioAOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_pmFilterRatioBOSBuffer);
+        // Allocate oversampled block buffers, base-rate phase state and linear-phase filter
+        // stages in one block
+        const int osBlockSize = bufferSize() * m_osRatio;
+        const auto filterDesign = OversamplingUtils::resolveFilterDesign(in0(FilterDesign));
+        OversamplingUtils::VariableOversampling::FIRStages* firStagesA = nullptr;
+        OversamplingUtils::VariableOversampling::FIRStages* firStagesB = nullptr;
+        m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+            m_outputOSBufferA = arena.buffer<float>(osBlockSize);
+            m_outputOSBufferB = arena.buffer<float>(osBlockSize);
+            m_cyclePosAOSBuffer = arena.buffer<float>(osBlockSize);
+            m_cyclePosBOSBuffer = arena.buffer<float>(osBlockSize);
+            m_pmIndexAOSBuffer = arena.buffer<float>(osBlockSize);
+            m_pmIndexBOSBuffer = arena.buffer<float>(osBlockSize);
+            m_pmFilterRatioAOSBuffer = arena.buffer<float>(osBlockSize);
+            m_pmFilterRatioBOSBuffer = arena.buffer<float>(osBlockSize);
+            m_phaseABlock = arena.buffer<float>(bufferSize());
+            m_phaseBBlock = arena.buffer<float>(bufferSize());
+            m_slopeABlock = arena.buffer<float>(bufferSize());
+            m_slopeBBlock = arena.buffer<float>(bufferSize());
+            if (filterDesign == OversamplingUtils::FilterDesign::LinearPhase) {
+                firStagesA = arena.object<OversamplingUtils::VariableOversampling::FIRStages>();
+                firStagesB = arena.object<OversamplingUtils::VariableOversampling::FIRStages>();
+            }
+        });
+        if (!m_arena.valid()) {
+            return;
+        }
 
         // Setup oversampling filters
-        m_outputOversamplingA.init(m_osRatio, m_sampleRate, m_outputOSBufferA);
-        m_outputOversamplingB.init(m_osRatio, m_sampleRate, m_outputOSBufferB);
-        m_cyclePosAOversampling.init(m_osRatio, m_sampleRate, m_cyclePosAOSBuffer);
-        m_cyclePosBOversampling.init(m_osRatio, m_sampleRate, m_cyclePosBOSBuffer);
-        m_pmIndexAOversampling.init(m_osRatio, m_sampleRate, m_pmIndexAOSBuffer);
-        m_pmIndexBOversampling.init(m_osRatio, m_sampleRate, m_pmIndexBOSBuffer);
-        m_pmFilterRatioAOversampling.init(m_osRatio, m_sampleRate, m_pmFilterRatioAOSBuffer);
-        m_pmFilterRatioBOversampling.init(m_osRatio, m_sampleRate, m_pmFilterRatioBOSBuffer);
+        m_outputOversamplingA.init(m_osRatio, filterDesign, firStagesA);
+        m_outputOversamplingB.init(m_osRatio, filterDesign, firStagesB);
+        m_paramOversampling.init(m_osRatio, {
+            !isCyclePosAAudioRate, !isCyclePosBAAudioRate,
+            !isPMIndexAAudioRate, !isPMIndexBAudioRate,
+            !isPMFilterRatioAAudioRate, !isPMFilterRatioBAudioRate
+        }, {
+            cyclePosAPast, cyclePosBPast,
+            pmIndexAPast, pmIndexBPast,
+            pmFilterRatioAPast, pmFilterRatioBPast
+        });
     }
     
-    // Set calc function & compute initial sample
-    set_calc_function<DualOscOS, &DualOscOS::next>();
+    // Resolve interpolation quality and input rates into calc function & compute initial sample
+    switch (OscUtils::resolveInterpQuality(in0(Interp))) {
+        case OscUtils::InterpLinear:
+            setCalcFunction<OscUtils::LinearInterp>();
+            break;
+        case OscUtils::InterpCubic:
+            setCalcFunction<OscUtils::CubicInterp>();
+            break;
+        case OscUtils::InterpSinc16:
+            setCalcFunction<OscUtils::SincInterp<16>>();
+            break;
+        case OscUtils::InterpSinc32:
+            setCalcFunction<OscUtils::SincInterp<32>>();
+            break;
+        default:
+            setCalcFunction<OscUtils::SincInterp<8>>();
+            break;
+    }
 }
 
 DualOscOS::~DualOscOS() {
-    RTFree(mWorld, m_outputOSBufferA);
-    RTFree(mWorld, m_outputOSBufferB);
-    RTFree(mWorld, m_cyclePosAOSBuffer);
-    RTFree(mWorld, m_cyclePosBOSBuffer);
-    RTFree(mWorld, m_pmIndexAOSBuffer);
-    RTFree(mWorld, m_pmIndexBOSBuffer);
-    RTFree(mWorld, m_pmFilterRatioAOSBuffer);
-    RTFree(mWorld, m_pmFilterRatioBOSBuffer);
+    m_arena.free(mWorld);
+}
+
+template<typename Interpolator>
+void DualOscOS::setCalcFunction() {
+
+    // Control-rate instances skip all per-sample rate checks
+    const bool audioRateInputs = isCyclePosAAudioRate ||
+        isCyclePosBAAudioRate ||
+        isPMIndexAAudioRate ||
+        isPMIndexBAudioRate ||
+        isPMFilterRatioAAudioRate ||
+        isPMFilterRatioBAudioRate;
+
+    if (audioRateInputs) {
+        set_calc_function<DualOscOS, &DualOscOS::next<Interpolator, true>>();
+    } else {
+        set_calc_function<DualOscOS, &DualOscOS::next<Interpolator, false>>();
+    }
 }
 
+template<typename Interpolator, bool AudioRateInputs>
 void DualOscOS::next(int nSamples) {
 
     // Audio-rate inputs
@@ -244,18 +351,14 @@ void DualOscOS::next(int nSamples) {
     float* outputB = out(OutB);
 
     // Get wavetable data
-    auto oscTableA = m_oscBufUnitA.GetTable(this, bufNumA, "DualOscOS OscA");
-    auto oscTableB = m_oscBufUnitB.GetTable(this, bufNumB, "DualOscOS OscB");
+    auto oscTableA = m_oscBufUnitA.GetTable(this, bufNumA, numCyclesA, "DualOscOS OscA");
+    auto oscTableB = m_oscBufUnitB.GetTable(this, bufNumB, numCyclesB, "DualOscOS OscB");
     if (!oscTableA.valid || !oscTableB.valid) {
         ClearUnitOutputs(this, nSamples);
         return;
     }
     
-    // Calculate samples per cycle
-    int cycleSamplesA = oscTableA.size / numCyclesA;
-    int cycleSamplesB = oscTableB.size / numCyclesB;
-    
-    if (m_oversampleIndex == 0) {
+    if (m_oversampleIndex == 0 && !m_autoOversample) {
 
         for (int i = 0; i < nSamples; ++i) {
 
@@ -264,27 +367,27 @@ void DualOscOS::next(int nSamples) {
             float phaseB = sc_frac(phaseBIn[i]);
 
             // Get current parameter values (audio-rate or interpolated control-rate)
-            float cyclePosAVal = isCyclePosAAudioRate ? 
+            float cyclePosAVal = (AudioRateInputs && isCyclePosAAudioRate) ? 
                 sc_clip(in(CyclePosA)[i], 0.0f, 1.0f) : 
                 slopedCyclePosA.consume();
 
-            float cyclePosBVal = isCyclePosBAAudioRate ? 
+            float cyclePosBVal = (AudioRateInputs && isCyclePosBAAudioRate) ? 
                 sc_clip(in(CyclePosB)[i], 0.0f, 1.0f) : 
                 slopedCyclePosB.consume();
 
-            float pmIndexAVal = isPMIndexAAudioRate ? 
+            float pmIndexAVal = (AudioRateInputs && isPMIndexAAudioRate) ? 
                 sc_clip(in(PMIndexA)[i], 0.0f, 10.0f) : 
                 slopedPMIndexA.consume();
 
-            float pmIndexBVal = isPMIndexBAudioRate ? 
+            float pmIndexBVal = (AudioRateInputs && isPMIndexBAudioRate) ? 
                 sc_clip(in(PMIndexB)[i], 0.0f, 10.0f) : 
                 slopedPMIndexB.consume();
 
-            float pmFilterRatioAVal = isPMFilterRatioAAudioRate ? 
+            float pmFilterRatioAVal = (AudioRateInputs && isPMFilterRatioAAudioRate) ? 
                 sc_clip(in(PMFilterRatioA)[i], 1.0f, 10.0f) : 
                 slopedPMFilterRatioA.consume();
 
-            float pmFilterRatioBVal = isPMFilterRatioBAudioRate ? 
+            float pmFilterRatioBVal = (AudioRateInputs && isPMFilterRatioBAudioRate) ? 
                 sc_clip(in(PMFilterRatioB)[i], 1.0f, 10.0f) : 
                 slopedPMFilterRatioB.consume();
             
@@ -292,37 +395,20 @@ void DualOscOS::next(int nSamples) {
             float slopeA = static_cast<float>(m_rampToSlopeA.process(static_cast<double>(phaseA)));
             float slopeB = static_cast<float>(m_rampToSlopeB.process(static_cast<double>(phaseB)));
             
-            // Calculate mipmap parameters for oscillator A (use ceil for no oversampling)
-            float rangeSizeA = static_cast<float>(cycleSamplesA);
-            float samplesPerFrameA = std::abs(slopeA) * rangeSizeA;
-            float octaveA = sc_max(0.0f, sc_log2(samplesPerFrameA));
-            int layerA = static_cast<int>(sc_ceil(octaveA));
-
-            // Calculate spacings for adjacent mipmap levels for oscillator A
-            int spacing1A = 1 << layerA;
-            int spacing2A = spacing1A << 1;
-            float crossfadeA = sc_frac(octaveA);
+            // Calculate mipmap level and crossfade for oscillator A (use ceil for no oversampling)
+            const OscUtils::MipmapLevel levelA = OscUtils::mipmapLevel(slopeA, oscTableA.cycleSamples, false);
             
-            // Calculate mipmap parameters for oscillator B (use ceil for no oversampling)
-            float rangeSizeB = static_cast<float>(cycleSamplesB);
-            float samplesPerFrameB = std::abs(slopeB) * rangeSizeB;
-            float octaveB = sc_max(0.0f, sc_log2(samplesPerFrameB));
-            int layerB = static_cast<int>(sc_ceil(octaveB));
-
-            // Calculate spacings for adjacent mipmap levels for oscillator B
-            int spacing1B = 1 << layerB;
-            int spacing2B = spacing1B << 1;
-            float crossfadeB = sc_frac(octaveB);
+            // Calculate mipmap level and crossfade for oscillator B (use ceil for no oversampling)
+            const OscUtils::MipmapLevel levelB = OscUtils::mipmapLevel(slopeB, oscTableB.cycleSamples, false);
             
             // Process dual wavetable oscillator
-            auto result = m_dualOsc.process(
+            auto result = m_dualOsc.process<Interpolator>(
                 phaseA, phaseB, cyclePosAVal, cyclePosBVal,
                 slopeA, slopeB, pmIndexAVal, pmIndexBVal,
                 pmFilterRatioAVal, pmFilterRatioBVal,
-                spacing1A, spacing2A, crossfadeA,
-                spacing1B, spacing2B, crossfadeB,
-                oscTableA.data, cycleSamplesA, numCyclesA,
-                oscTableB.data, cycleSamplesB, numCyclesB
+                levelA.layer, levelA.crossfade,
+                levelB.layer, levelB.crossfade,
+                oscTableA, oscTableB
             );
             
             outputA[i] = result.oscA;
@@ -330,6 +416,9 @@ void DualOscOS::next(int nSamples) {
         }
     } else {
 
+        float maxSlope = 0.0f;
+        float maxPMIndex = 0.0f;
+
         for (int i = 0; i < nSamples; ++i) {
 
             // Wrap phases between 0 and 1
@@ -337,63 +426,64 @@ void DualOscOS::next(int nSamples) {
             float phaseB = sc_frac(phaseBIn[i]);
 
             // Get current parameter values (audio-rate or interpolated control-rate)
-            float cyclePosAVal = isCyclePosAAudioRate ? 
+            m_cyclePosAOSBuffer[i] = (AudioRateInputs && isCyclePosAAudioRate) ? 
                 sc_clip(in(CyclePosA)[i], 0.0f, 1.0f) : 
                 slopedCyclePosA.consume();
 
-            float cyclePosBVal = isCyclePosBAAudioRate ? 
+            m_cyclePosBOSBuffer[i] = (AudioRateInputs && isCyclePosBAAudioRate) ? 
                 sc_clip(in(CyclePosB)[i], 0.0f, 1.0f) : 
                 slopedCyclePosB.consume();
 
-            float pmIndexAVal = isPMIndexAAudioRate ? 
+            m_pmIndexAOSBuffer[i] = (AudioRateInputs && isPMIndexAAudioRate) ? 
                 sc_clip(in(PMIndexA)[i], 0.0f, 10.0f) : 
                 slopedPMIndexA.consume();
 
-            float pmIndexBVal = isPMIndexBAudioRate ? 
+            m_pmIndexBOSBuffer[i] = (AudioRateInputs && isPMIndexBAudioRate) ? 
                 sc_clip(in(PMIndexB)[i], 0.0f, 10.0f) : 
                 slopedPMIndexB.consume();
 
-            float pmFilterRatioAVal = isPMFilterRatioAAudioRate ? 
+            m_pmFilterRatioAOSBuffer[i] = (AudioRateInputs && isPMFilterRatioAAudioRate) ? 
                 sc_clip(in(PMFilterRatioA)[i], 1.0f, 10.0f) : 
                 slopedPMFilterRatioA.consume();
 
-            float pmFilterRatioBVal = isPMFilterRatioBAudioRate ? 
+            m_pmFilterRatioBOSBuffer[i] = (AudioRateInputs && isPMFilterRatioBAudioRate) ? 
                 sc_clip(in(PMFilterRatioB)[i], 1.0f, 10.0f) : 
                 slopedPMFilterRatioB.consume();
 
             // Calculate slopes
-            float slopeA = static_cast<float>(m_rampToSlopeA.process(static_cast<double>(phaseA)));
-            float slopeB = static_cast<float>(m_rampToSlopeB.process(static_cast<double>(phaseB)));
-            
-            // Calculate mipmap parameters for oscillator A (use floor for oversampling)
-            float rangeSizeA = static_cast<float>(cycleSamplesA);
-            float samplesPerFrameA = std::abs(slopeA) * rangeSizeA;
-            float octaveA = sc_max(0.0f, sc_log2(samplesPerFrameA));
-            int layerA = static_cast<int>(sc_floor(octaveA));
-
-            // Calculate spacings for adjacent mipmap levels for oscillator A
-            int spacing1A = 1 << layerA;
-            int spacing2A = spacing1A << 1;
-            float crossfadeA = sc_frac(octaveA);
+            m_phaseABlock[i] = phaseA;
+            m_phaseBBlock[i] = phaseB;
+            m_slopeABlock[i] = static_cast<float>(m_rampToSlopeA.process(static_cast<double>(phaseA)));
+            m_slopeBBlock[i] = static_cast<float>(m_rampToSlopeB.process(static_cast<double>(phaseB)));
+
+            maxSlope = sc_max(maxSlope, sc_max(std::abs(m_slopeABlock[i]), std::abs(m_slopeBBlock[i])));
+            maxPMIndex = sc_max(maxPMIndex, sc_max(m_pmIndexAOSBuffer[i], m_pmIndexBOSBuffer[i]));
+        }
+
+        // Pick this block's ratio from the fastest slope and the deepest phase modulation
+        if (m_autoOversample) {
+            setOversampleIndex(m_adaptiveRatio.process(maxSlope, maxPMIndex));
+        }
+        
+        // Upsample all parameter values for the whole block in one pass (ramped if control-rate)
+        m_paramOversampling.upsampleBlock({
+            m_cyclePosAOSBuffer, m_cyclePosBOSBuffer,
+            m_pmIndexAOSBuffer, m_pmIndexBOSBuffer,
+            m_pmFilterRatioAOSBuffer, m_pmFilterRatioBOSBuffer
+        }, nSamples);
+
+        for (int i = 0; i < nSamples; ++i) {
+
+            float phaseA = m_phaseABlock[i];
+            float phaseB = m_phaseBBlock[i];
+            float slopeA = m_slopeABlock[i];
+            float slopeB = m_slopeBBlock[i];
             
-            // Calculate mipmap parameters for oscillator B (use floor for oversampling)
-            float rangeSizeB = static_cast<float>(cycleSamplesB);
-            float samplesPerFrameB = std::abs(slopeB) * rangeSizeB;
-            float octaveB = sc_max(0.0f, sc_log2(samplesPerFrameB));
-            int layerB = static_cast<int>(sc_floor(octaveB));
-
-            // Calculate spacings for adjacent mipmap levels for oscillator B
-            int spacing1B = 1 << layerB;
-            int spacing2B = spacing1B << 1;
-            float crossfadeB = sc_frac(octaveB);
+            // Calculate mipmap level and crossfade for oscillator A (use floor for oversampling, ceil otherwise)
+            const OscUtils::MipmapLevel levelA = OscUtils::mipmapLevel(slopeA, oscTableA.cycleSamples, m_osRatio > 1);
             
-            // Upsample parameter values
-            m_cyclePosAOversampling.upsample(cyclePosAVal);
-            m_cyclePosBOversampling.upsample(cyclePosBVal);
-            m_pmIndexAOversampling.upsample(pmIndexAVal);
-            m_pmIndexBOversampling.upsample(pmIndexBVal);
-            m_pmFilterRatioAOversampling.upsample(pmFilterRatioAVal);
-            m_pmFilterRatioBOversampling.upsample(pmFilterRatioBVal);
+            // Calculate mipmap level and crossfade for oscillator B (use floor for oversampling, ceil otherwise)
+            const OscUtils::MipmapLevel levelB = OscUtils::mipmapLevel(slopeB, oscTableB.cycleSamples, m_osRatio > 1);
 
             // Initialize phases and slopes for oversampling
             float osSlopeA = slopeA / static_cast<float>(m_osRatio);
@@ -401,41 +491,37 @@ void DualOscOS::next(int nSamples) {
             float osPhaseA = phaseA - slopeA;
             float osPhaseB = phaseB - slopeB;
             
-            for (int k = 0; k < m_osRatio; k++) {
-                
-                // Clamp upsampled values
-                m_cyclePosAOSBuffer[k] = sc_clip(m_cyclePosAOSBuffer[k], 0.0f, 1.0f);
-                m_cyclePosBOSBuffer[k] = sc_clip(m_cyclePosBOSBuffer[k], 0.0f, 1.0f);
-                m_pmIndexAOSBuffer[k] = sc_clip(m_pmIndexAOSBuffer[k], 0.0f, 10.0f);
-                m_pmIndexBOSBuffer[k] = sc_clip(m_pmIndexBOSBuffer[k], 0.0f, 10.0f);
-                m_pmFilterRatioAOSBuffer[k] = sc_clip(m_pmFilterRatioAOSBuffer[k], 1.0f, 10.0f);
-                m_pmFilterRatioBOSBuffer[k] = sc_clip(m_pmFilterRatioBOSBuffer[k], 1.0f, 10.0f);
+            const int osOffset = i * m_osRatio;
+            
+            for (int k = osOffset; k < osOffset + m_osRatio; k++) {
                 
                 // Increment oversampled phases
                 osPhaseA += osSlopeA;
                 osPhaseB += osSlopeB;
                 
-                // Process dual wavetable oscillator with upsampled parameter values
-                auto result = m_dualOsc.process(
+                // Process dual wavetable oscillator with clamped upsampled parameter values
+                auto result = m_dualOsc.process<Interpolator>(
                     sc_frac(osPhaseA), sc_frac(osPhaseB),
-                    m_cyclePosAOSBuffer[k], m_cyclePosBOSBuffer[k],
+                    sc_clip(m_cyclePosAOSBuffer[k], 0.0f, 1.0f), 
+                    sc_clip(m_cyclePosBOSBuffer[k], 0.0f, 1.0f),
                     osSlopeA, osSlopeB,
-                    m_pmIndexAOSBuffer[k], m_pmIndexBOSBuffer[k],
-                    m_pmFilterRatioAOSBuffer[k], m_pmFilterRatioBOSBuffer[k],
-                    spacing1A, spacing2A, crossfadeA,
-                    spacing1B, spacing2B, crossfadeB,
-                    oscTableA.data, cycleSamplesA, numCyclesA,
-                    oscTableB.data, cycleSamplesB, numCyclesB
+                    sc_clip(m_pmIndexAOSBuffer[k], 0.0f, 10.0f), 
+                    sc_clip(m_pmIndexBOSBuffer[k], 0.0f, 10.0f),
+                    sc_clip(m_pmFilterRatioAOSBuffer[k], 1.0f, 10.0f), 
+                    sc_clip(m_pmFilterRatioBOSBuffer[k], 1.0f, 10.0f),
+                    levelA.layer, levelA.crossfade,
+                    levelB.layer, levelB.crossfade,
+                    oscTableA, oscTableB
                 );
                 
                 m_outputOSBufferA[k] = result.oscA;
                 m_outputOSBufferB[k] = result.oscB;
             }
-            
-            // Downsample outputs
-            outputA[i] = m_outputOversamplingA.downsample();
-            outputB[i] = m_outputOversamplingB.downsample();
         }
+        
+        // Downsample outputs for the whole block
+        m_outputOversamplingA.downsampleBlock(m_outputOSBufferA, outputA, nSamples);
+        m_outputOversamplingB.downsampleBlock(m_outputOSBufferB, outputB, nSamples);
     }
 
     // Update parameter cache (use last value if audio-rate, otherwise slope value)
@@ -462,6 +548,19 @@ void DualOscOS::next(int nSamples) {
     pmFilterRatioBPast = isPMFilterRatioBAudioRate ? 
         sc_clip(in(PMFilterRatioB)[nSamples - 1], 1.0f, 10.0f) : 
         slopedPMFilterRatioB.value;
+
+    // Delay of the decimation filters in samples, glides to the new ratio in auto mode
+    if (m_latencyOutput) {
+        m_outputOversamplingA.downsampleLatencyBlock(out(Latency), nSamples);
+    }
+}
+
+void DualOscOS::setOversampleIndex(int index) {
+    m_oversampleIndex = index;
+    m_osRatio = 1 << index;
+    m_outputOversamplingA.setRatio(m_osRatio);
+    m_outputOversamplingB.setRatio(m_osRatio);
+    m_paramOversampling.setRatio(m_osRatio);
 }
 
 // ===== PULSAR OSCILLATOR =====
@@ -469,8 +568,15 @@ void DualOscOS::next(int nSamples) {
 PulsarOS::PulsarOS() : 
     m_sampleRate(static_cast<float>(sampleRate())),
     m_sampleDur(static_cast<float>(sampleDur())),
-    m_oversampleIndex(sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
-    m_osRatio(1 << m_oversampleIndex)
+    m_autoOversample(OversamplingUtils::isAutoOversample(in0(Oversample))),
+    m_oversampleIndex(m_autoOversample ?
+        OversamplingUtils::MAX_OVERSAMPLE_INDEX :
+        sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
+    m_osRatio(1 << m_oversampleIndex),
+    m_numVoices(EventUtils::resolveVoiceCount(in0(MaxVoices))),
+    m_voicePolicy(EventUtils::resolveVoicePolicy(in0(VoicePolicy))),
+    m_stealFadeSamples(sc_max(static_cast<int>(EventUtils::STEAL_FADE_TIME * m_sampleRate), 1)),
+    m_overflowOutput(numOutputs() > 1)
 {
     // Initialize parameter cache
     oscCyclePosPast = sc_clip(in0(OscCyclePos), 0.0f, 1.0f);
@@ -488,45 +594,272 @@ PulsarOS::PulsarOS() :
     isEnvCyclePosAudioRate = isAudioRateIn(EnvCyclePos);
     isModCyclePosAudioRate = isAudioRateIn(ModCyclePos);
     
-    // Initialize oversampling
+    // Initialize oversampling filters, parameters are upsampled in place in the block buffers
     if (m_oversampleIndex > 0) {
-        auto unit = this;
-
-        // Allocate oversampling buffers
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_oscCyclePosOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_envCyclePosOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_modCyclePosOSBuffer);
-
-        // Setup oversampling filters
-        m_outputOversampling.init(m_osRatio, m_sampleRate, m_outputOSBuffer);
-        m_oscCyclePosOversampling.init(m_osRatio, m_sampleRate, m_oscCyclePosOSBuffer);
-        m_envCyclePosOversampling.init(m_osRatio, m_sampleRate, m_envCyclePosOSBuffer);
-        m_modCyclePosOversampling.init(m_osRatio, m_sampleRate, m_modCyclePosOSBuffer);
+        m_outputOversampling.init(m_osRatio);
+        m_paramOversampling.init(m_osRatio, {
+            !isOscCyclePosAudioRate, !isEnvCyclePosAudioRate, !isModCyclePosAudioRate
+        }, {
+            oscCyclePosPast, envCyclePosPast, modCyclePosPast
+        });
     }
     
-    // Set calc function & compute initial sample
-    set_calc_function<PulsarOS, &PulsarOS::next>();
+    // Resolve interpolation quality and input rates into calc function & compute initial sample
+    switch (OscUtils::resolveInterpQuality(in0(Interp))) {
+        case OscUtils::InterpLinear:
+            setCalcFunction<OscUtils::LinearInterp>();
+            break;
+        case OscUtils::InterpCubic:
+            setCalcFunction<OscUtils::CubicInterp>();
+            break;
+        case OscUtils::InterpSinc16:
+            setCalcFunction<OscUtils::SincInterp<16>>();
+            break;
+        case OscUtils::InterpSinc32:
+            setCalcFunction<OscUtils::SincInterp<32>>();
+            break;
+        default:
+            setCalcFunction<OscUtils::SincInterp<8>>();
+            break;
+    }
     
     // Reset state after priming
-    m_allocator.reset();
     m_trigger.reset();
 }
  
 PulsarOS::~PulsarOS() {
-    RTFree(mWorld, m_outputOSBuffer);
-    RTFree(mWorld, m_oscCyclePosOSBuffer);
-    RTFree(mWorld, m_envCyclePosOSBuffer);
-    RTFree(mWorld, m_modCyclePosOSBuffer);
+    m_arena.free(mWorld);
 }
  
+template<typename Interpolator>
+void PulsarOS::setCalcFunction() {
+
+    // Resolve voice count into allocator instantiation
+    switch (m_numVoices) {
+        case 4:
+            setVoiceCalcFunction<Interpolator, 4>();
+            break;
+        case 8:
+            setVoiceCalcFunction<Interpolator, 8>();
+            break;
+        case 32:
+            setVoiceCalcFunction<Interpolator, 32>();
+            break;
+        case 64:
+            setVoiceCalcFunction<Interpolator, 64>();
+            break;
+        case 128:
+            setVoiceCalcFunction<Interpolator, 128>();
+            break;
+        default:
+            setVoiceCalcFunction<Interpolator, 16>();
+            break;
+    }
+}
+
+template<typename Interpolator, int NumVoices>
+void PulsarOS::setVoiceCalcFunction() {
+
+    // Allocate grain voices and block buffers for voice-major rendering in one block
+    auto unit = this;
+    const int blockSize = bufferSize() * m_osRatio;
+    VoiceBank<NumVoices>* voices = nullptr;
+    m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+        voices = arena.object<VoiceBank<NumVoices>>();
+        m_events = arena.buffer<GrainEvent>(bufferSize());
+        m_oscCyclePosBlock = arena.buffer<float>(blockSize);
+        m_envCyclePosBlock = arena.buffer<float>(blockSize);
+        m_modCyclePosBlock = arena.buffer<float>(blockSize);
+        m_outputBlock = arena.buffer<float>(blockSize);
+        if (m_overflowOutput) {
+            m_overflowBlock = arena.buffer<float>(bufferSize());
+        }
+    });
+    if (!voices) {
+        return;
+    }
+    m_voiceBank = voices;
+
+    // Instances with control-rate parameters skip all per-sample rate checks. The scheduler inputs
+    // are left out, they are audio-rate in the usual setup and are read with a stride instead
+    const bool audioRateInputs = isOscFreqAudioRate ||
+        isModFreqAudioRate ||
+        isModIndexAudioRate ||
+        isOscCyclePosAudioRate ||
+        isEnvCyclePosAudioRate ||
+        isModCyclePosAudioRate;
+
+    if (audioRateInputs) {
+        set_calc_function<PulsarOS, &PulsarOS::next<Interpolator, true, NumVoices>>();
+    } else {
+        set_calc_function<PulsarOS, &PulsarOS::next<Interpolator, false, NumVoices>>();
+    }
+
+    // Reset voices after priming
+    new (voices) VoiceBank<NumVoices>();
+    voices->allocator.policy = m_voicePolicy;
+}
+
+template<typename Interpolator>
+int PulsarOS::renderGrain(GrainData& grain, FilterUtils::OnePoleSlope& pmFilter,
+    const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& envTable, const OscUtils::Wavetable& modTable,
+    int start, int end, float gain, float gainSlope) {
+
+    // Keep the grain state local for the whole span
+    const float oscSlope = grain.oscSlope;
+    const float modSlope = grain.modSlope;
+    const double envPhaseInc = grain.envSlope;
+    const float envSlope = static_cast<float>(envPhaseInc);
+    const float modScaleRatio = grain.modScaleRatio;
+    const float modIndex = grain.modIndex;
+    const OscUtils::MipmapLevel oscLevel = grain.oscLevel;
+    const OscUtils::MipmapLevel modLevel = grain.modLevel;
+    const OscUtils::MipmapLevel envLevel = grain.envLevel;
+    double envPhase = grain.envPhase;
+    double sampleCount = grain.sampleCount;
+
+    int i = start;
+
+    if (m_oversampleIndex == 0) {
+
+        do {
+            // Accumulate osc and mod phases
+            float oscPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(oscSlope)));
+            float modPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(modSlope)));
+            float windowPhase = envPhase < 1.0 ? static_cast<float>(envPhase) : 0.0f;
+
+            // Process mod wavetable oscillator
+            float modOsc = OscUtils::wavetableOsc<Interpolator>(
+                modPhase, modTable, m_modCyclePosBlock[i],
+                modLevel.layer, modLevel.crossfade
+            );
+
+            // Apply Phase Modulation
+            float modFiltered = pmFilter.processLowpass(modOsc, modSlope);
+            float modScaled = modFiltered / Utils::TWO_PI * modScaleRatio;
+            float modulatedOscPhase = sc_frac(oscPhase + (modScaled * modIndex));
+
+            // Process osc wavetable oscillator
+            float grainOsc = OscUtils::wavetableOsc<Interpolator>(
+                modulatedOscPhase, oscTable, m_oscCyclePosBlock[i],
+                oscLevel.layer, oscLevel.crossfade
+            );
+
+            // Process env wavetable oscillator
+            float grainWindow = OscUtils::wavetableOsc<Interpolator>(
+                windowPhase, envTable, m_envCyclePosBlock[i],
+                envLevel.layer, envLevel.crossfade
+            );
+
+            // Accumulate grain output
+            m_outputBlock[i] += grainOsc * grainWindow * gain;
+
+            // Increment sample count, window phase and fade gain
+            sampleCount++;
+            envPhase += envPhaseInc;
+            gain += gainSlope;
+            ++i;
+        } while (i < end && envPhase < 1.0);
+
+    } else {
+
+        // Oversampled slopes
+        const float osModSlope = modSlope / static_cast<float>(m_osRatio);
+        const float osOscSlope = oscSlope / static_cast<float>(m_osRatio);
+        const float osEnvSlope = envSlope / static_cast<float>(m_osRatio);
+
+        do {
+            // Accumulate osc and mod phases
+            float oscPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(oscSlope)));
+            float modPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(modSlope)));
+            float windowPhase = envPhase < 1.0 ? static_cast<float>(envPhase) : 0.0f;
+
+            // Initialize phases for oversampling
+            float osModPhase = modPhase - modSlope;
+            float osOscPhase = oscPhase - oscSlope;
+            float osEnvPhase = windowPhase - envSlope;
+
+            const int base = i * m_osRatio;
+            for (int k = 0; k < m_osRatio; k++) {
+
+                // Increment oversampled phases
+                osModPhase += osModSlope;
+                osOscPhase += osOscSlope;
+                osEnvPhase += osEnvSlope;
+
+                // Process mod wavetable oscillator
+                float modOsc = OscUtils::wavetableOsc<Interpolator>(
+                    sc_frac(osModPhase), modTable, m_modCyclePosBlock[base + k],
+                    modLevel.layer, modLevel.crossfade
+                );
+
+                // Apply Phase Modulation
+                float modFiltered = pmFilter.processLowpass(modOsc, osModSlope);
+                float modScaled = modFiltered / Utils::TWO_PI * modScaleRatio;
+                float modulatedOscPhase = sc_frac(osOscPhase + (modScaled * modIndex));
+
+                // Process osc wavetable oscillator
+                float grainOsc = OscUtils::wavetableOsc<Interpolator>(
+                    modulatedOscPhase, oscTable, m_oscCyclePosBlock[base + k],
+                    oscLevel.layer, oscLevel.crossfade
+                );
+
+                // Process env wavetable oscillator
+                float grainWindow = OscUtils::wavetableOsc<Interpolator>(
+                    osEnvPhase, envTable, m_envCyclePosBlock[base + k],
+                    envLevel.layer, envLevel.crossfade
+                );
+
+                // Accumulate grain output
+                m_outputBlock[base + k] += grainOsc * grainWindow * gain;
+            }
+
+            // Increment sample count, window phase and fade gain
+            sampleCount++;
+            envPhase += envPhaseInc;
+            gain += gainSlope;
+            ++i;
+        } while (i < end && envPhase < 1.0);
+    }
+
+    // Store grain state, the voice is freed once its window completes
+    grain.envPhase = envPhase;
+    grain.sampleCount = sampleCount;
+    if (envPhase >= 1.0) {
+        grain.active = false;
+    }
+
+    return i;
+}
+
+template<typename Interpolator>
+bool PulsarOS::renderTail(GrainTail& tail,
+    const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& envTable, const OscUtils::Wavetable& modTable,
+    int start, int end) {
+
+    // Linear fade-out over the remaining steal fade samples
+    const float fadeStep = 1.0f / static_cast<float>(m_stealFadeSamples);
+    const int stop = renderGrain<Interpolator>(
+        tail.grain, tail.pmFilter, oscTable, envTable, modTable,
+        start, sc_min(end, start + tail.remaining),
+        static_cast<float>(tail.remaining) * fadeStep, -fadeStep
+    );
+
+    tail.remaining -= stop - start;
+    return tail.remaining > 0 && tail.grain.active;
+}
+
+template<typename Interpolator, bool AudioRateInputs, int NumVoices>
 void PulsarOS::next(int nSamples) {
-    
+
+    // Grain voices
+    auto& voices = *static_cast<VoiceBank<NumVoices>*>(m_voiceBank);
+
     // Control-rate parameters with smooth interpolation
     auto slopedOscCyclePos = makeSlope(sc_clip(in0(OscCyclePos), 0.0f, 1.0f), oscCyclePosPast);
     auto slopedEnvCyclePos = makeSlope(sc_clip(in0(EnvCyclePos), 0.0f, 1.0f), envCyclePosPast);
     auto slopedModCyclePos = makeSlope(sc_clip(in0(ModCyclePos), 0.0f, 1.0f), modCyclePosPast);
-    
+
     // Control-rate parameters (settings, no interpolation)
     float oscBufNum = in0(OscBuffer);
     float envBufNum = in0(EnvBuffer);
@@ -534,856 +867,1032 @@ void PulsarOS::next(int nSamples) {
     int oscNumCycles = sc_max(static_cast<int>(in0(OscNumCycles)), 1);
     int envNumCycles = sc_max(static_cast<int>(in0(EnvNumCycles)), 1);
     int modNumCycles = sc_max(static_cast<int>(in0(ModNumCycles)), 1);
-    
+
+    // Control-rate parameters (read once per block)
+    const float controlOscFreq = sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+    const float controlModFreq = sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+    const float controlModIndex = sc_clip(in0(ModIndex), 0.0f, 10.0f);
+
     // Output pointer
     float* output = out(Out);
 
     // Get wavetable data
-    auto oscTable = m_oscBufUnit.GetTable(this, oscBufNum, "PulsarOS osc");
-    auto envTable = m_envBufUnit.GetTable(this, envBufNum, "PulsarOS env");
-    auto modTable = m_modBufUnit.GetTable(this, modBufNum, "PulsarOS mod");
+    auto oscTable = m_oscBufUnit.GetTable(this, oscBufNum, oscNumCycles, "PulsarOS osc");
+    auto envTable = m_envBufUnit.GetTable(this, envBufNum, envNumCycles, "PulsarOS env");
+    auto modTable = m_modBufUnit.GetTable(this, modBufNum, modNumCycles, "PulsarOS mod");
     if (!oscTable.valid || !envTable.valid || !modTable.valid) {
         ClearUnitOutputs(this, nSamples);
         return;
     }
 
-    // Calculate samples per cycle
-    int oscCycleSamples = oscTable.size / oscNumCycles;
-    int envCycleSamples = envTable.size / envNumCycles;
-    int modCycleSamples = modTable.size / modNumCycles;
-    
-    if (m_oversampleIndex == 0) {
- 
-        for (int i = 0; i < nSamples; ++i) {
-            
-            // Trigger input (audio-rate or control-rate)
-            bool trigger = isTriggerAudioRate ? 
-                m_trigger.process(in(Trigger)[i]) : 
-                m_trigger.process(in0(Trigger));
-            
-            // Get current parameter values (no interpolation - latched per trigger)
-            float triggerFreq = isTriggerFreqAudioRate ? 
-                sc_clip(in(TriggerFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
-                sc_clip(in0(TriggerFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
-            
-            float offset = isSubSampleOffsetAudioRate ? 
-                in(SubSampleOffset)[i] : 
-                in0(SubSampleOffset);
- 
-            float oscFreq = isOscFreqAudioRate ? 
+    // Scheduler inputs, a zero stride repeats the control-rate value without a per-sample rate check
+    const float* triggerIn = in(Trigger);
+    const float* triggerFreqIn = in(TriggerFreq);
+    const float* offsetIn = in(SubSampleOffset);
+    const int triggerStride = isTriggerAudioRate ? 1 : 0;
+    const int triggerFreqStride = isTriggerFreqAudioRate ? 1 : 0;
+    const int offsetStride = isSubSampleOffsetAudioRate ? 1 : 0;
+
+    // 1. Resolve trigger events and per-sample parameters for the whole block
+    int numEvents = 0;
+
+    // Voices live at block start or triggered within it
+    EventUtils::VoiceMask<NumVoices> liveVoices = voices.allocator.active;
+
+    for (int i = 0; i < nSamples; ++i) {
+
+        // Trigger input (audio-rate or control-rate)
+        bool trigger = m_trigger.process(triggerIn[i * triggerStride]);
+
+        // Get current parameter values (no interpolation - latched per trigger)
+        float triggerFreq = sc_clip(triggerFreqIn[i * triggerFreqStride], m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        float offset = offsetIn[i * offsetStride];
+
+        // Get current parameter values (audio-rate or interpolated control-rate)
+        float oscCyclePosVal = (AudioRateInputs && isOscCyclePosAudioRate) ?
+            sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
+            slopedOscCyclePos.consume();
+
+        float envCyclePosVal = (AudioRateInputs && isEnvCyclePosAudioRate) ?
+            sc_clip(in(EnvCyclePos)[i], 0.0f, 1.0f) :
+            slopedEnvCyclePos.consume();
+
+        float modCyclePosVal = (AudioRateInputs && isModCyclePosAudioRate) ?
+            sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
+            slopedModCyclePos.consume();
+
+        // Store parameter values (upsampled after the event pass when oversampling)
+        m_oscCyclePosBlock[i] = oscCyclePosVal;
+        m_envCyclePosBlock[i] = envCyclePosVal;
+        m_modCyclePosBlock[i] = modCyclePosVal;
+
+        // Process voice allocation and record the event for the allocated voice
+        int voice = voices.allocator.process(
+            trigger,
+            triggerFreq,
+            offset,
+            m_sampleRate
+        );
+
+        if (voice >= 0) {
+            float oscFreq = (AudioRateInputs && isOscFreqAudioRate) ?
                 sc_clip(in(OscFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f); 
-            
-            float modFreq = isModFreqAudioRate ? 
-                sc_clip(in(ModFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
-                sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float modIndex = isModIndexAudioRate ? 
-                sc_clip(in(ModIndex)[i], 0.0f, 10.0f) : 
-                sc_clip(in0(ModIndex), 0.0f, 10.0f);
-            
-            // Get current parameter values (audio-rate or interpolated control-rate)            
-            float oscCyclePosVal = isOscCyclePosAudioRate ?
-                sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
-                slopedOscCyclePos.consume();
-            
-            float envCyclePosVal = isEnvCyclePosAudioRate ?
-                sc_clip(in(EnvCyclePos)[i], 0.0f, 1.0f) :
-                slopedEnvCyclePos.consume();
- 
-            float modCyclePosVal = isModCyclePosAudioRate ?
-                sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
-                slopedModCyclePos.consume();
-            
-            // 1. Process voice allocation
-            m_allocator.process(
-                trigger,
-                triggerFreq,
-                offset,
-                m_sampleRate
-            );
-            
-            // 2. Process all grains
-            float sum = 0.0f;
-            for (int g = 0; g < NUM_VOICES; ++g) {
-                
-                // Trigger new grain if needed and store graindata
-                if (m_allocator.triggers[g]) {
-                    m_grainData[g].oscFreq = oscFreq;
-                    m_grainData[g].modFreq = modFreq;
-                    m_grainData[g].modIndex = modIndex;
-                    m_grainData[g].sampleCount = offset;
-                    m_pmFilters[g].reset();
-                }
-                
-                // Process grain if voice is active
-                if (m_allocator.isActive[g]) {
-                    
-                    // Calculate slopes
-                    float oscSlope = m_grainData[g].oscFreq * m_sampleDur;
-                    float envSlope = static_cast<float>(m_allocator.localSlopes[g]);
-                    float modSlope = m_grainData[g].modFreq * m_sampleDur;
- 
-                    // Accumulate osc and mod phases
-                    float oscPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(oscSlope)));
-                    float modPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(modSlope)));
- 
-                    // Calculate mipmap parameters for mod (use ceil for no oversampling)
-                    float modRangeSize = static_cast<float>(modCycleSamples);
-                    float modSamplesPerFrame = std::abs(modSlope) * modRangeSize;
-                    float modOctave = sc_max(0.0f, sc_log2(modSamplesPerFrame));
-                    int modLayer = static_cast<int>(sc_ceil(modOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for mod
-                    int modSpacing1 = 1 << modLayer;
-                    int modSpacing2 = modSpacing1 << 1;
-                    float modCrossfade = sc_frac(modOctave);
-                    
-                    // Process mod wavetable oscillator
-                    float modOsc = OscUtils::wavetableOsc(
-                        modPhase, modTable.data, 
-                        modCycleSamples, modNumCycles, modCyclePosVal,
-                        modSpacing1, modSpacing2, modCrossfade
-                    );
- 
-                    // Calculate mipmap parameters for osc (use ceil for no oversampling)
-                    float oscRangeSize = static_cast<float>(oscCycleSamples);
-                    float oscSamplesPerFrame = std::abs(oscSlope) * oscRangeSize;
-                    float oscOctave = sc_max(0.0f, sc_log2(oscSamplesPerFrame));
-                    int oscLayer = static_cast<int>(sc_ceil(oscOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for osc
-                    int oscSpacing1 = 1 << oscLayer;
-                    int oscSpacing2 = oscSpacing1 << 1;
-                    float oscCrossfade = sc_frac(oscOctave);
- 
-                    // Calculate mod scale ratio for PM
-                    float modScaleRatio = 0.0f;
-                    if (sc_abs(modSlope) > Utils::SAFE_DENOM_EPSILON) {
-                        modScaleRatio = sc_abs(oscSlope / modSlope);
-                    }
- 
-                    // Apply Phase Modulation
-                    float modFiltered = m_pmFilters[g].processLowpass(modOsc, modSlope);
-                    float modScaled = modFiltered / Utils::TWO_PI * modScaleRatio;
-                    float modulatedOscPhase = sc_frac(oscPhase + (modScaled * m_grainData[g].modIndex));
-                    
-                    // Process osc wavetable oscillator
-                    float grainOsc = OscUtils::wavetableOsc(
-                        modulatedOscPhase, oscTable.data, 
-                        oscCycleSamples, oscNumCycles, oscCyclePosVal,
-                        oscSpacing1, oscSpacing2, oscCrossfade
-                    );
-                    
-                    // Calculate mipmap parameters for env (use ceil for no oversampling)
-                    float envRangeSize = static_cast<float>(envCycleSamples);
-                    float envSamplesPerFrame = std::abs(envSlope) * envRangeSize;
-                    float envOctave = sc_max(0.0f, sc_log2(envSamplesPerFrame));
-                    int envLayer = static_cast<int>(sc_ceil(envOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for env
-                    int envSpacing1 = 1 << envLayer;
-                    int envSpacing2 = envSpacing1 << 1;
-                    float envCrossfade = sc_frac(envOctave);
-                    
-                    // Process env wavetable oscillator
-                    float grainWindow = OscUtils::wavetableOsc(
-                        m_allocator.phases[g], envTable.data, 
-                        envCycleSamples, envNumCycles, envCyclePosVal,
-                        envSpacing1, envSpacing2, envCrossfade
-                    );
-                    
-                    // Accumulate grain output
-                    sum += grainOsc * grainWindow;
- 
-                    // Increment sample count
-                    m_grainData[g].sampleCount++;
-                }
-            }
-            
-            // 3. DC block output
-            output[i] = m_dcBlocker.processHighpass(sum, 3.0f, m_sampleRate);
+                controlOscFreq;
+
+            float modFreq = (AudioRateInputs && isModFreqAudioRate) ?
+                sc_clip(in(ModFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
+                controlModFreq;
+
+            float modIndex = (AudioRateInputs && isModIndexAudioRate) ?
+                sc_clip(in(ModIndex)[i], 0.0f, 10.0f) :
+                controlModIndex;
+
+            GrainEvent& event = m_events[numEvents++];
+            event.sample = i;
+            event.voice = voice;
+            liveVoices.set(voice);
+            event.offset = offset;
+            event.oscSlope = oscFreq * m_sampleDur;
+            event.modSlope = modFreq * m_sampleDur;
+            event.modIndex = modIndex;
+            event.envSlope = voices.allocator.localSlopes[voice];
         }
-    } else {
- 
-        for (int i = 0; i < nSamples; ++i) {
-            
-            // Trigger input (audio-rate or control-rate)
-            bool trigger = isTriggerAudioRate ? 
-                m_trigger.process(in(Trigger)[i]) : 
-                m_trigger.process(in0(Trigger));
-            
-            // Get current parameter values (no interpolation - latched per trigger)
-            float triggerFreq = isTriggerFreqAudioRate ? 
-                sc_clip(in(TriggerFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
-                sc_clip(in0(TriggerFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
-            
-            float offset = isSubSampleOffsetAudioRate ? 
-                in(SubSampleOffset)[i] : 
-                in0(SubSampleOffset);
- 
-            float oscFreq = isOscFreqAudioRate ? 
-                sc_clip(in(OscFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f); 
-            
-            float modFreq = isModFreqAudioRate ? 
-                sc_clip(in(ModFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) : 
-                sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float modIndex = isModIndexAudioRate ? 
-                sc_clip(in(ModIndex)[i], 0.0f, 10.0f) : 
-                sc_clip(in0(ModIndex), 0.0f, 10.0f);
-            
-            // Get current parameter values (audio-rate or interpolated control-rate)            
-            float oscCyclePosVal = isOscCyclePosAudioRate ?
-                sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
-                slopedOscCyclePos.consume();
-            
-            float envCyclePosVal = isEnvCyclePosAudioRate ?
-                sc_clip(in(EnvCyclePos)[i], 0.0f, 1.0f) :
-                slopedEnvCyclePos.consume();
- 
-            float modCyclePosVal = isModCyclePosAudioRate ?
-                sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
-                slopedModCyclePos.consume();
-        
-            // 1. Process voice allocation
-            m_allocator.process(
-                trigger,
-                triggerFreq,
-                offset,
-                m_sampleRate
-            );
-            
-            // 2. Upsample parameter values
-            m_oscCyclePosOversampling.upsample(oscCyclePosVal);
-            m_envCyclePosOversampling.upsample(envCyclePosVal);
-            m_modCyclePosOversampling.upsample(modCyclePosVal);
-            
-            // 3. Clear OS buffer
-            memset(m_outputOSBuffer, 0, m_osRatio * sizeof(float));
-            
-            // 4. Process all grains
-            for (int g = 0; g < NUM_VOICES; ++g) {
-                
-                // Trigger new grain if needed and store graindata
-                if (m_allocator.triggers[g]) {
-                    m_grainData[g].oscFreq = oscFreq;
-                    m_grainData[g].modFreq = modFreq;
-                    m_grainData[g].modIndex = modIndex;
-                    m_grainData[g].sampleCount = offset;
-                    m_pmFilters[g].reset();
-                }
-                
-                // Process grain if voice is active
-                if (m_allocator.isActive[g]) {
-                    
-                    // Calculate slopes
-                    float oscSlope = m_grainData[g].oscFreq * m_sampleDur;
-                    float envSlope = static_cast<float>(m_allocator.localSlopes[g]);
-                    float modSlope = m_grainData[g].modFreq * m_sampleDur;
- 
-                    // Accumulate osc and mod phases
-                    float oscPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(oscSlope)));
-                    float modPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(modSlope)));
- 
-                    // Calculate mipmap parameters for mod (use floor for oversampling)
-                    float modRangeSize = static_cast<float>(modCycleSamples);
-                    float modSamplesPerFrame = std::abs(modSlope) * modRangeSize;
-                    float modOctave = sc_max(0.0f, sc_log2(modSamplesPerFrame));
-                    int modLayer = static_cast<int>(sc_floor(modOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for mod
-                    int modSpacing1 = 1 << modLayer;
-                    int modSpacing2 = modSpacing1 << 1;
-                    float modCrossfade = sc_frac(modOctave);
- 
-                    // Calculate mipmap parameters for osc (use floor for oversampling)
-                    float oscRangeSize = static_cast<float>(oscCycleSamples);
-                    float oscSamplesPerFrame = std::abs(oscSlope) * oscRangeSize;
-                    float oscOctave = sc_max(0.0f, sc_log2(oscSamplesPerFrame));
-                    int oscLayer = static_cast<int>(sc_floor(oscOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for osc
-                    int oscSpacing1 = 1 << oscLayer;
-                    int oscSpacing2 = oscSpacing1 << 1;
-                    float oscCrossfade = sc_frac(oscOctave);
-                    
-                    // Initialize mod phase and slope for oversampling
-                    float osModSlope = modSlope / static_cast<float>(m_osRatio);
-                    float osModPhase = modPhase - modSlope;
-                    
-                    // Initialize osc phase and slope for oversampling
-                    float osOscSlope = oscSlope / static_cast<float>(m_osRatio);
-                    float osOscPhase = oscPhase - oscSlope;
-                    
-                    // Initialize env phase and slope for oversampling
-                    float osEnvSlope = envSlope / static_cast<float>(m_osRatio);
-                    float osEnvPhase = m_allocator.phases[g] - envSlope;
-                    
-                    // Calculate mipmap parameters for env (use floor for oversampling)
-                    float envRangeSize = static_cast<float>(envCycleSamples);
-                    float envSamplesPerFrame = std::abs(envSlope) * envRangeSize;
-                    float envOctave = sc_max(0.0f, sc_log2(envSamplesPerFrame));
-                    int envLayer = static_cast<int>(sc_floor(envOctave));
-                    
-                    // Calculate spacings for adjacent mipmap levels for env
-                    int envSpacing1 = 1 << envLayer;
-                    int envSpacing2 = envSpacing1 << 1;
-                    float envCrossfade = sc_frac(envOctave);
- 
-                    // Calculate mod scale ratio for PM
-                    float modScaleRatio = 0.0f;
-                    if (sc_abs(modSlope) > Utils::SAFE_DENOM_EPSILON) {
-                        modScaleRatio = sc_abs(oscSlope / modSlope);
-                    }
-                    
-                    for (int k = 0; k < m_osRatio; k++) {
-                        
-                        // Clamp upsampled values
-                        m_oscCyclePosOSBuffer[k] = sc_clip(m_oscCyclePosOSBuffer[k], 0.0f, 1.0f);
-                        m_envCyclePosOSBuffer[k] = sc_clip(m_envCyclePosOSBuffer[k], 0.0f, 1.0f);
-                        m_modCyclePosOSBuffer[k] = sc_clip(m_modCyclePosOSBuffer[k], 0.0f, 1.0f);
-                        
-                        // Increment oversampled phases
-                        osModPhase += osModSlope;
-                        osOscPhase += osOscSlope;
-                        osEnvPhase += osEnvSlope;
-                        
-                        // Process mod wavetable oscillator
-                        float modOsc = OscUtils::wavetableOsc(
-                            sc_frac(osModPhase), modTable.data, 
-                            modCycleSamples, modNumCycles, m_modCyclePosOSBuffer[k],
-                            modSpacing1, modSpacing2, modCrossfade
-                        );
-                        
-                        // Apply Phase Modulation
-                        float modFiltered = m_pmFilters[g].processLowpass(modOsc, osModSlope);
-                        float modScaled = modFiltered / Utils::TWO_PI * modScaleRatio;
-                        float modulatedOscPhase = sc_frac(osOscPhase + (modScaled * m_grainData[g].modIndex));
-                        
-                        // Process osc wavetable oscillator
-                        float grainOsc = OscUtils::wavetableOsc(
-                            modulatedOscPhase, oscTable.data, 
-                            oscCycleSamples, oscNumCycles, m_oscCyclePosOSBuffer[k],
-                            oscSpacing1, oscSpacing2, oscCrossfade
-                        );
-                        
-                        // Process env wavetable oscillator
-                        float grainWindow = OscUtils::wavetableOsc(
-                            osEnvPhase, envTable.data, 
-                            envCycleSamples, envNumCycles, m_envCyclePosOSBuffer[k],
-                            envSpacing1, envSpacing2, envCrossfade
-                        );
-                        
-                        // Accumulate grain output
-                        m_outputOSBuffer[k] += grainOsc * grainWindow;
-                    }
- 
-                    // Increment sample count
-                    m_grainData[g].sampleCount++;
-                }
-            }
-            
-            // 5. Downsample and DC block output
-            output[i] = m_dcBlocker.processHighpass(m_outputOversampling.downsample(), 3.0f, m_sampleRate);
+
+        if (m_overflowOutput) {
+            m_overflowBlock[i] = static_cast<float>(voices.allocator.overflowCount);
         }
     }
-    
-    // Update parameter cache (use last value if audio-rate, otherwise slope value)
-    oscCyclePosPast = isOscCyclePosAudioRate ? 
+
+    // Update parameter cache before writing output, which may alias the inputs
+    oscCyclePosPast = isOscCyclePosAudioRate ?
         sc_clip(in(OscCyclePos)[nSamples - 1], 0.0f, 1.0f) : slopedOscCyclePos.value;
-        
-    envCyclePosPast = isEnvCyclePosAudioRate ? 
+
+    envCyclePosPast = isEnvCyclePosAudioRate ?
         sc_clip(in(EnvCyclePos)[nSamples - 1], 0.0f, 1.0f) : slopedEnvCyclePos.value;
- 
-    modCyclePosPast = isModCyclePosAudioRate ? 
+
+    modCyclePosPast = isModCyclePosAudioRate ?
         sc_clip(in(ModCyclePos)[nSamples - 1], 0.0f, 1.0f) : slopedModCyclePos.value;
-}
 
-// ===== DUAL PULSAR OSCILLATOR =====
- 
-DualPulsarOS::DualPulsarOS() :
-    m_sampleRate(static_cast<float>(sampleRate())),
-    m_sampleDur(static_cast<float>(sampleDur())),
-    m_oversampleIndex(sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
-    m_osRatio(1 << m_oversampleIndex)
-{
-    // Initialize parameter cache (sloped params)
-    oscCyclePosPast = sc_clip(in0(OscCyclePos), 0.0f, 1.0f);
-    modCyclePosPast = sc_clip(in0(ModCyclePos), 0.0f, 1.0f);
-    skewPast = sc_clip(in0(Skew), 0.0f, 1.0f);
-    indexPast = sc_clip(in0(Index), 0.0f, 10.0f);
- 
-    // Check which inputs are audio-rate
-    isTriggerAudioRate = isAudioRateIn(Trigger);
-    isTriggerFreqAudioRate = isAudioRateIn(TriggerFreq);
-    isSubSampleOffsetAudioRate = isAudioRateIn(SubSampleOffset);
-    isOscFreqAudioRate = isAudioRateIn(OscFreq);
-    isModFreqAudioRate = isAudioRateIn(ModFreq);
-    isPmIndexOscAudioRate = isAudioRateIn(PmIndexOsc);
-    isPmIndexModAudioRate = isAudioRateIn(PmIndexMod);
-    isPmFilterRatioOscAudioRate = isAudioRateIn(PmFilterRatioOsc);
-    isPmFilterRatioModAudioRate = isAudioRateIn(PmFilterRatioMod);
-    isWarpOscAudioRate = isAudioRateIn(WarpOsc);
-    isWarpModAudioRate = isAudioRateIn(WarpMod);
-    isOscCyclePosAudioRate = isAudioRateIn(OscCyclePos);
-    isModCyclePosAudioRate = isAudioRateIn(ModCyclePos);
-    isSkewAudioRate = isAudioRateIn(Skew);
-    isIndexAudioRate = isAudioRateIn(Index);
- 
-    // Initialize oversampling
-    if (m_oversampleIndex > 0) {
-        auto unit = this;
+    // Pick this block's ratio from the fastest grain and the deepest phase modulation
+    if (m_autoOversample) {
+        float maxSlope = 0.0f;
+        float maxModIndex = 0.0f;
+        for (int g : liveVoices) {
+            const GrainData& grain = voices.grainData[g];
+            if (grain.active) {
+                maxSlope = sc_max(maxSlope, sc_max(sc_abs(grain.oscSlope), sc_abs(grain.modSlope)));
+                maxModIndex = sc_max(maxModIndex, grain.modIndex);
+            }
+        }
+        for (int e = 0; e < numEvents; ++e) {
+            const GrainEvent& event = m_events[e];
+            maxSlope = sc_max(maxSlope, sc_max(sc_abs(event.oscSlope), sc_abs(event.modSlope)));
+            maxModIndex = sc_max(maxModIndex, event.modIndex);
+        }
+        setOversampleIndex(m_adaptiveRatio.process(maxSlope, maxModIndex));
+    }
 
-        // Allocate oversampling buffers
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_outputOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_oscCyclePosOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_modCyclePosOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_skewOSBuffer);
-        PluginUtils::allocBuffer(unit, mWorld, m_osRatio, m_indexOSBuffer);
+    const bool oversampled = m_oversampleIndex > 0;
 
-        // Setup oversampling filters
-        m_outputOversampling.init(m_osRatio, m_sampleRate, m_outputOSBuffer);
-        m_oscCyclePosOversampling.init(m_osRatio, m_sampleRate, m_oscCyclePosOSBuffer);
-        m_modCyclePosOversampling.init(m_osRatio, m_sampleRate, m_modCyclePosOSBuffer);
-        m_skewOversampling.init(m_osRatio, m_sampleRate, m_skewOSBuffer);
-        m_indexOversampling.init(m_osRatio, m_sampleRate, m_indexOSBuffer);
+    // Upsample all parameter values in one pass, control-rate values are ramped
+    if (oversampled) {
+        m_paramOversampling.upsampleBlock({
+            m_oscCyclePosBlock, m_envCyclePosBlock, m_modCyclePosBlock
+        }, nSamples);
+
+        // Only the half-band path for audio-rate values can overshoot the parameter range
+        if (m_paramOversampling.filtered()) {
+            for (int k = 0; k < nSamples * m_osRatio; k++) {
+                m_oscCyclePosBlock[k] = sc_clip(m_oscCyclePosBlock[k], 0.0f, 1.0f);
+                m_envCyclePosBlock[k] = sc_clip(m_envCyclePosBlock[k], 0.0f, 1.0f);
+                m_modCyclePosBlock[k] = sc_clip(m_modCyclePosBlock[k], 0.0f, 1.0f);
+            }
+        }
+    }
+
+    // 2. Render each voice across its live span of the block
+    memset(m_outputBlock, 0, nSamples * m_osRatio * sizeof(float));
+
+    // Stolen grains still fading out from previous blocks
+    for (int g : voices.fading) {
+        if (!renderTail<Interpolator>(voices.tails[g], oscTable, envTable, modTable, 0, nSamples)) {
+            voices.fading.clear(g);
+        }
     }
+
+    for (int g : liveVoices) {
+
+        GrainData& grain = voices.grainData[g];
+        int eventIndex = 0;
+        int i = 0;
+
+        while (i < nSamples) {
+
+            // The next trigger event of this voice bounds the current span
+            int eventSample = EventUtils::nextVoiceEvent(m_events, numEvents, g, eventIndex, nSamples);
+
+            if (i == eventSample) {
+
+                // Stolen voice: hand the running grain over to a short fade-out
+                if (grain.active) {
+                    GrainTail& tail = voices.tails[g];
+                    tail.grain = grain;
+                    tail.pmFilter = voices.pmFilters[g];
+                    tail.remaining = m_stealFadeSamples;
+                    if (renderTail<Interpolator>(tail, oscTable, envTable, modTable, i, nSamples)) {
+                        voices.fading.set(g);
+                    } else {
+                        voices.fading.clear(g);
+                    }
+                }
+
+                // Store graindata of the triggered grain
+                const GrainEvent& event = m_events[eventIndex++];
+
+                grain.modIndex = event.modIndex;
+                grain.sampleCount = event.offset;
+                voices.pmFilters[g].reset();
+
+                // Latch slopes for the lifetime of the grain
+                grain.oscSlope = event.oscSlope;
+                grain.modSlope = event.modSlope;
+                grain.envSlope = event.envSlope;
+                grain.envPhase = event.envSlope * event.offset;
+                grain.active = true;
+
+                // Calculate mod scale ratio for PM
+                grain.modScaleRatio = 0.0f;
+                if (sc_abs(grain.modSlope) > Utils::SAFE_DENOM_EPSILON) {
+                    grain.modScaleRatio = sc_abs(grain.oscSlope / grain.modSlope);
+                }
+
+                // Latch mipmap parameters (use floor for oversampling, ceil otherwise)
+                grain.oscLevel = OscUtils::mipmapLevel(grain.oscSlope, oscTable.cycleSamples, oversampled);
+                grain.modLevel = OscUtils::mipmapLevel(grain.modSlope, modTable.cycleSamples, oversampled);
+                grain.envLevel = OscUtils::mipmapLevel(static_cast<float>(grain.envSlope), envTable.cycleSamples, oversampled);
+
+                eventSample = EventUtils::nextVoiceEvent(m_events, numEvents, g, eventIndex, nSamples);
+
+            } else if (!grain.active) {
+
+                // Idle voice: jump to its next trigger event
+                i = eventSample;
+                continue;
+            }
+
+            i = renderGrain<Interpolator>(
+                grain, voices.pmFilters[g], oscTable, envTable, modTable,
+                i, eventSample, 1.0f, 0.0f
+            );
+        }
+    }
+
+    // 3. Downsample and DC block output, in auto mode also at 1x to glide out a ratio change
+    if (oversampled || m_autoOversample) {
+        m_outputOversampling.downsampleBlock(m_outputBlock, m_outputBlock, nSamples);
+    }
+    for (int i = 0; i < nSamples; ++i) {
+        output[i] = m_dcBlocker.processHighpass(m_outputBlock[i], 3.0f, m_sampleRate);
+    }
+
+    // 4. Running count of triggers which found all voices busy
+    if (m_overflowOutput) {
+        memcpy(out(Overflow), m_overflowBlock, nSamples * sizeof(float));
+    }
+}
+
+void PulsarOS::setOversampleIndex(int index) {
+    m_oversampleIndex = index;
+    m_osRatio = 1 << index;
+    m_outputOversampling.setRatio(m_osRatio);
+    m_paramOversampling.setRatio(m_osRatio);
+}
+
+// ===== DUAL PULSAR OSCILLATOR =====
  
-    // Set calc function & compute initial sample
-    set_calc_function<DualPulsarOS, &DualPulsarOS::next>();
+DualPulsarOS::DualPulsarOS() :
+    m_sampleRate(static_cast<float>(sampleRate())),
+    m_sampleDur(static_cast<float>(sampleDur())),
+    m_autoOversample(OversamplingUtils::isAutoOversample(in0(Oversample))),
+    m_oversampleIndex(m_autoOversample ?
+        OversamplingUtils::MAX_OVERSAMPLE_INDEX :
+        sc_clip(static_cast<int>(in0(Oversample)), 0, 4)),
+    m_osRatio(1 << m_oversampleIndex),
+    m_numVoices(EventUtils::resolveVoiceCount(in0(MaxVoices))),
+    m_voicePolicy(EventUtils::resolveVoicePolicy(in0(VoicePolicy))),
+    m_stealFadeSamples(sc_max(static_cast<int>(EventUtils::STEAL_FADE_TIME * m_sampleRate), 1)),
+    m_overflowOutput(numOutputs() > 1)
+{
+    // Initialize parameter cache (sloped params)
+    oscCyclePosPast = sc_clip(in0(OscCyclePos), 0.0f, 1.0f);
+    modCyclePosPast = sc_clip(in0(ModCyclePos), 0.0f, 1.0f);
+    skewPast = sc_clip(in0(Skew), 0.0f, 1.0f);
+    indexPast = sc_clip(in0(Index), 0.0f, 10.0f);
+ 
+    // Check which inputs are audio-rate
+    isTriggerAudioRate = isAudioRateIn(Trigger);
+    isTriggerFreqAudioRate = isAudioRateIn(TriggerFreq);
+    isSubSampleOffsetAudioRate = isAudioRateIn(SubSampleOffset);
+    isOscFreqAudioRate = isAudioRateIn(OscFreq);
+    isModFreqAudioRate = isAudioRateIn(ModFreq);
+    isPmIndexOscAudioRate = isAudioRateIn(PmIndexOsc);
+    isPmIndexModAudioRate = isAudioRateIn(PmIndexMod);
+    isPmFilterRatioOscAudioRate = isAudioRateIn(PmFilterRatioOsc);
+    isPmFilterRatioModAudioRate = isAudioRateIn(PmFilterRatioMod);
+    isWarpOscAudioRate = isAudioRateIn(WarpOsc);
+    isWarpModAudioRate = isAudioRateIn(WarpMod);
+    isOscCyclePosAudioRate = isAudioRateIn(OscCyclePos);
+    isModCyclePosAudioRate = isAudioRateIn(ModCyclePos);
+    isSkewAudioRate = isAudioRateIn(Skew);
+    isIndexAudioRate = isAudioRateIn(Index);
+ 
+    // Initialize oversampling filters, parameters are upsampled in place in the block buffers
+    if (m_oversampleIndex > 0) {
+        m_outputOversampling.init(m_osRatio);
+        m_paramOversampling.init(m_osRatio, {
+            !isOscCyclePosAudioRate, !isModCyclePosAudioRate, !isSkewAudioRate, !isIndexAudioRate
+        }, {
+            oscCyclePosPast, modCyclePosPast, skewPast, indexPast
+        });
+    }
+ 
+    // Resolve interpolation quality and input rates into calc function & compute initial sample
+    switch (OscUtils::resolveInterpQuality(in0(Interp))) {
+        case OscUtils::InterpLinear:
+            setCalcFunction<OscUtils::LinearInterp>();
+            break;
+        case OscUtils::InterpCubic:
+            setCalcFunction<OscUtils::CubicInterp>();
+            break;
+        case OscUtils::InterpSinc16:
+            setCalcFunction<OscUtils::SincInterp<16>>();
+            break;
+        case OscUtils::InterpSinc32:
+            setCalcFunction<OscUtils::SincInterp<32>>();
+            break;
+        default:
+            setCalcFunction<OscUtils::SincInterp<8>>();
+            break;
+    }
  
     // Reset state after priming
-    m_allocator.reset();
     m_trigger.reset();
 }
  
 DualPulsarOS::~DualPulsarOS() {
-    RTFree(mWorld, m_outputOSBuffer);
-    RTFree(mWorld, m_oscCyclePosOSBuffer);
-    RTFree(mWorld, m_modCyclePosOSBuffer);
-    RTFree(mWorld, m_skewOSBuffer);
-    RTFree(mWorld, m_indexOSBuffer);
+    m_arena.free(mWorld);
 }
  
+template<typename Interpolator>
+void DualPulsarOS::setCalcFunction() {
+
+    // Resolve voice count into allocator instantiation
+    switch (m_numVoices) {
+        case 4:
+            setVoiceCalcFunction<Interpolator, 4>();
+            break;
+        case 8:
+            setVoiceCalcFunction<Interpolator, 8>();
+            break;
+        case 32:
+            setVoiceCalcFunction<Interpolator, 32>();
+            break;
+        case 64:
+            setVoiceCalcFunction<Interpolator, 64>();
+            break;
+        case 128:
+            setVoiceCalcFunction<Interpolator, 128>();
+            break;
+        default:
+            setVoiceCalcFunction<Interpolator, 16>();
+            break;
+    }
+}
+
+template<typename Interpolator, int NumVoices>
+void DualPulsarOS::setVoiceCalcFunction() {
+
+    // Allocate grain voices and block buffers for voice-major rendering in one block
+    auto unit = this;
+    const int blockSize = bufferSize() * m_osRatio;
+    VoiceBank<NumVoices>* voices = nullptr;
+    m_arena.allocate(unit, mWorld, [&](PluginUtils::RTArena& arena) {
+        voices = arena.object<VoiceBank<NumVoices>>();
+        m_events = arena.buffer<GrainEvent>(bufferSize());
+        m_oscCyclePosBlock = arena.buffer<float>(blockSize);
+        m_modCyclePosBlock = arena.buffer<float>(blockSize);
+        m_skewBlock = arena.buffer<float>(blockSize);
+        m_indexBlock = arena.buffer<float>(blockSize);
+        m_outputBlock = arena.buffer<float>(blockSize);
+        if (m_overflowOutput) {
+            m_overflowBlock = arena.buffer<float>(bufferSize());
+        }
+    });
+    if (!voices) {
+        return;
+    }
+    m_voiceBank = voices;
+
+    // Instances with control-rate parameters skip all per-sample rate checks. The scheduler inputs
+    // are left out, they are audio-rate in the usual setup and are read with a stride instead
+    const bool audioRateInputs = isOscFreqAudioRate ||
+        isModFreqAudioRate ||
+        isPmIndexOscAudioRate ||
+        isPmIndexModAudioRate ||
+        isPmFilterRatioOscAudioRate ||
+        isPmFilterRatioModAudioRate ||
+        isWarpOscAudioRate ||
+        isWarpModAudioRate ||
+        isOscCyclePosAudioRate ||
+        isModCyclePosAudioRate ||
+        isSkewAudioRate ||
+        isIndexAudioRate;
+
+    if (audioRateInputs) {
+        set_calc_function<DualPulsarOS, &DualPulsarOS::next<Interpolator, true, NumVoices>>();
+    } else {
+        set_calc_function<DualPulsarOS, &DualPulsarOS::next<Interpolator, false, NumVoices>>();
+    }
+
+    // Reset voices after priming
+    new (voices) VoiceBank<NumVoices>();
+    voices->allocator.policy = m_voicePolicy;
+}
+
+template<typename Interpolator>
+int DualPulsarOS::renderGrain(GrainData& grain, OscUtils::DualOscScaled& dualOsc,
+    const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& modTable,
+    int start, int end, float gain, float gainSlope) {
+
+    // Keep the grain state local for the whole span
+    const GrainData params = grain;
+    const double envPhaseInc = grain.envSlope;
+    const float envSlope = static_cast<float>(envPhaseInc);
+    double envPhase = grain.envPhase;
+    double sampleCount = grain.sampleCount;
+
+    int i = start;
+
+    if (m_oversampleIndex == 0) {
+
+        do {
+            // Derive osc and mod phases from sample count
+            float oscPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(params.oscSlope)));
+            float modPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(params.modSlope)));
+            float windowPhase = envPhase < 1.0 ? static_cast<float>(envPhase) : 0.0f;
+
+            // Apply Phase increment distortion
+            float phsIncDistOsc = Easing::Interp::jCurve(windowPhase, params.warpOsc, Easing::Cores::cubic) - windowPhase;
+            float oscPhaseDistorted = sc_frac(oscPhase + (phsIncDistOsc * params.phsIncRatioOsc));
+
+            float phsIncDistMod = Easing::Interp::jCurve(windowPhase, params.warpMod, Easing::Cores::cubic) - windowPhase;
+            float modPhaseDistorted = sc_frac(modPhase + (phsIncDistMod * params.phsIncRatioMod));
+
+            // Process cross-modulated dual oscillator
+            auto result = dualOsc.process<Interpolator>(
+                oscPhaseDistorted, modPhaseDistorted,
+                m_oscCyclePosBlock[i], m_modCyclePosBlock[i],
+                params.oscSlope, params.modSlope,
+                params.pmIndexOsc, params.pmIndexMod,
+                params.pmFilterRatioOsc, params.pmFilterRatioMod,
+                params.oscLevel.layer, params.oscLevel.crossfade,
+                params.modLevel.layer, params.modLevel.crossfade,
+                oscTable, modTable
+            );
+
+            // Process gaussian window
+            float grainWindow = WindowFunctions::gaussianWindow(
+                windowPhase, m_skewBlock[i], m_indexBlock[i]);
+
+            // Accumulate grain output
+            m_outputBlock[i] += result.oscA * grainWindow * gain;
+
+            // Increment sample count, window phase and fade gain
+            sampleCount++;
+            envPhase += envPhaseInc;
+            gain += gainSlope;
+            ++i;
+        } while (i < end && envPhase < 1.0);
+
+    } else {
+
+        // Oversampled slopes
+        const float osOscSlope = params.oscSlope / static_cast<float>(m_osRatio);
+        const float osModSlope = params.modSlope / static_cast<float>(m_osRatio);
+        const float osEnvSlope = envSlope / static_cast<float>(m_osRatio);
+
+        do {
+            // Derive osc and mod phases from sample count
+            float oscPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(params.oscSlope)));
+            float modPhase = static_cast<float>(sc_frac(sampleCount * static_cast<double>(params.modSlope)));
+            float windowPhase = envPhase < 1.0 ? static_cast<float>(envPhase) : 0.0f;
+
+            // Initialize phases for oversampling
+            float osOscPhase = oscPhase - params.oscSlope;
+            float osModPhase = modPhase - params.modSlope;
+            float osEnvPhase = windowPhase - envSlope;
+
+            const int base = i * m_osRatio;
+            for (int k = 0; k < m_osRatio; k++) {
+
+                // Increment oversampled phases
+                osOscPhase += osOscSlope;
+                osModPhase += osModSlope;
+                osEnvPhase += osEnvSlope;
+
+                // Apply phase increment distortion
+                float phsIncDistOsc = Easing::Interp::jCurve(osEnvPhase, params.warpOsc, Easing::Cores::cubic) - osEnvPhase;
+                float osOscPhaseDistorted = sc_frac(osOscPhase + (phsIncDistOsc * params.phsIncRatioOsc));
+
+                float phsIncDistMod = Easing::Interp::jCurve(osEnvPhase, params.warpMod, Easing::Cores::cubic) - osEnvPhase;
+                float osModPhaseDistorted = sc_frac(osModPhase + (phsIncDistMod * params.phsIncRatioMod));
+
+                // Process cross-modulated dual oscillator at oversampled rate
+                auto result = dualOsc.process<Interpolator>(
+                    osOscPhaseDistorted, osModPhaseDistorted,
+                    m_oscCyclePosBlock[base + k], m_modCyclePosBlock[base + k],
+                    osOscSlope, osModSlope,
+                    params.pmIndexOsc, params.pmIndexMod,
+                    params.pmFilterRatioOsc, params.pmFilterRatioMod,
+                    params.oscLevel.layer, params.oscLevel.crossfade,
+                    params.modLevel.layer, params.modLevel.crossfade,
+                    oscTable, modTable
+                );
+
+                // Process gaussian window with upsampled skew and index
+                float grainWindow = WindowFunctions::gaussianWindow(
+                    osEnvPhase, m_skewBlock[base + k], m_indexBlock[base + k]);
+
+                // Accumulate grain output
+                m_outputBlock[base + k] += result.oscA * grainWindow * gain;
+            }
+
+            // Increment sample count, window phase and fade gain
+            sampleCount++;
+            envPhase += envPhaseInc;
+            gain += gainSlope;
+            ++i;
+        } while (i < end && envPhase < 1.0);
+    }
+
+    // Store grain state, the voice is freed once its window completes
+    grain.envPhase = envPhase;
+    grain.sampleCount = sampleCount;
+    if (envPhase >= 1.0) {
+        grain.active = false;
+    }
+
+    return i;
+}
+
+template<typename Interpolator>
+bool DualPulsarOS::renderTail(GrainTail& tail,
+    const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& modTable,
+    int start, int end) {
+
+    // Linear fade-out over the remaining steal fade samples
+    const float fadeStep = 1.0f / static_cast<float>(m_stealFadeSamples);
+    const int stop = renderGrain<Interpolator>(
+        tail.grain, tail.dualOsc, oscTable, modTable,
+        start, sc_min(end, start + tail.remaining),
+        static_cast<float>(tail.remaining) * fadeStep, -fadeStep
+    );
+
+    tail.remaining -= stop - start;
+    return tail.remaining > 0 && tail.grain.active;
+}
+
+template<typename Interpolator, bool AudioRateInputs, int NumVoices>
 void DualPulsarOS::next(int nSamples) {
- 
+
+    // Grain voices
+    auto& voices = *static_cast<VoiceBank<NumVoices>*>(m_voiceBank);
+
     // Control-rate parameters with smooth interpolation (sloped params)
     auto slopedOscCyclePos = makeSlope(sc_clip(in0(OscCyclePos), 0.0f, 1.0f), oscCyclePosPast);
     auto slopedModCyclePos = makeSlope(sc_clip(in0(ModCyclePos), 0.0f, 1.0f), modCyclePosPast);
     auto slopedSkew = makeSlope(sc_clip(in0(Skew), 0.0f, 1.0f), skewPast);
     auto slopedIndex = makeSlope(sc_clip(in0(Index), 0.0f, 10.0f), indexPast);
- 
+
     // Control-rate parameters (settings, no interpolation)
     float oscBufNum = in0(OscBuffer);
     float modBufNum = in0(ModBuffer);
     int oscNumCycles = sc_max(static_cast<int>(in0(OscNumCycles)), 1);
     int modNumCycles = sc_max(static_cast<int>(in0(ModNumCycles)), 1);
- 
+
+    // Control-rate parameters (read once per block)
+    const float controlOscFreq = sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+    const float controlModFreq = sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+    const float controlPmIndexOsc = sc_clip(in0(PmIndexOsc), 0.0f, 10.0f);
+    const float controlPmIndexMod = sc_clip(in0(PmIndexMod), 0.0f, 10.0f);
+    const float controlPmFilterRatioOsc = sc_clip(in0(PmFilterRatioOsc), 1.0f, 10.0f);
+    const float controlPmFilterRatioMod = sc_clip(in0(PmFilterRatioMod), 1.0f, 10.0f);
+    const float controlWarpOsc = sc_clip(in0(WarpOsc), 0.0f, 1.0f);
+    const float controlWarpMod = sc_clip(in0(WarpMod), 0.0f, 1.0f);
+
     // Output pointer
     float* output = out(Out);
 
     // Get wavetable data
-    auto oscTable = m_oscBufUnit.GetTable(this, oscBufNum, "DualPulsarOS osc");
-    auto modTable = m_modBufUnit.GetTable(this, modBufNum, "DualPulsarOS mod");
+    auto oscTable = m_oscBufUnit.GetTable(this, oscBufNum, oscNumCycles, "DualPulsarOS osc");
+    auto modTable = m_modBufUnit.GetTable(this, modBufNum, modNumCycles, "DualPulsarOS mod");
     if (!oscTable.valid || !modTable.valid) {
         ClearUnitOutputs(this, nSamples);
         return;
     }
- 
-    // Calculate samples per cycle
-    int oscCycleSamples = oscTable.size / oscNumCycles;
-    int modCycleSamples = modTable.size / modNumCycles;
- 
-    if (m_oversampleIndex == 0) {
- 
-        for (int i = 0; i < nSamples; ++i) {
- 
-            // Trigger input (audio-rate or control-rate)
-            bool trigger = isTriggerAudioRate ?
-                m_trigger.process(in(Trigger)[i]) :
-                m_trigger.process(in0(Trigger));
- 
-            // Get current parameter values (no interpolation - latched per trigger)
-            float triggerFreq = isTriggerFreqAudioRate ?
-                sc_clip(in(TriggerFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(TriggerFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float offset = isSubSampleOffsetAudioRate ?
-                in(SubSampleOffset)[i] :
-                in0(SubSampleOffset);
- 
-            float oscFreq = isOscFreqAudioRate ?
-                sc_clip(in(OscFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float modFreq = isModFreqAudioRate ?
-                sc_clip(in(ModFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float pmIndexOsc = isPmIndexOscAudioRate ?
-                sc_clip(in(PmIndexOsc)[i], 0.0f, 10.0f) :
-                sc_clip(in0(PmIndexOsc), 0.0f, 10.0f);
- 
-            float pmIndexMod = isPmIndexModAudioRate ?
-                sc_clip(in(PmIndexMod)[i], 0.0f, 10.0f) :
-                sc_clip(in0(PmIndexMod), 0.0f, 10.0f);
- 
-            float pmFilterRatioOsc = isPmFilterRatioOscAudioRate ?
-                sc_clip(in(PmFilterRatioOsc)[i], 1.0f, 10.0f) :
-                sc_clip(in0(PmFilterRatioOsc), 1.0f, 10.0f);
- 
-            float pmFilterRatioMod = isPmFilterRatioModAudioRate ?
-                sc_clip(in(PmFilterRatioMod)[i], 1.0f, 10.0f) :
-                sc_clip(in0(PmFilterRatioMod), 1.0f, 10.0f);
- 
-            float warpOsc = isWarpOscAudioRate ?
-                sc_clip(in(WarpOsc)[i], 0.0f, 1.0f) :
-                sc_clip(in0(WarpOsc), 0.0f, 1.0f);
- 
-            float warpMod = isWarpModAudioRate ?
-                sc_clip(in(WarpMod)[i], 0.0f, 1.0f) :
-                sc_clip(in0(WarpMod), 0.0f, 1.0f);
- 
-            // Get current parameter values (audio-rate or interpolated control-rate)
-            float oscCyclePosVal = isOscCyclePosAudioRate ?
-                sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
-                slopedOscCyclePos.consume();
- 
-            float modCyclePosVal = isModCyclePosAudioRate ?
-                sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
-                slopedModCyclePos.consume();
- 
-            float skewVal = isSkewAudioRate ?
-                sc_clip(in(Skew)[i], 0.0f, 1.0f) :
-                slopedSkew.consume();
- 
-            float indexVal = isIndexAudioRate ?
-                sc_clip(in(Index)[i], 0.0f, 10.0f) :
-                slopedIndex.consume();
- 
-            // 1. Process voice allocation
-            m_allocator.process(
-                trigger,
-                triggerFreq,
-                offset,
-                m_sampleRate
-            );
- 
-            // 2. Process all grains
-            float sum = 0.0f;
-            for (int g = 0; g < NUM_VOICES; ++g) {
- 
-                // Trigger new grain if needed and store graindata
-                if (m_allocator.triggers[g]) {
-                    m_grainData[g].oscFreq = oscFreq;
-                    m_grainData[g].modFreq = modFreq;
-                    m_grainData[g].pmIndexOsc = pmIndexOsc;
-                    m_grainData[g].pmIndexMod = pmIndexMod;
-                    m_grainData[g].pmFilterRatioOsc = pmFilterRatioOsc;
-                    m_grainData[g].pmFilterRatioMod = pmFilterRatioMod;
-                    m_grainData[g].warpOsc = warpOsc;
-                    m_grainData[g].warpMod = warpMod;
-                    m_grainData[g].sampleCount = offset;
-                    m_dualOscs[g].reset();
-                }
- 
-                // Process grain if voice is active
-                if (m_allocator.isActive[g]) {
- 
-                    // Calculate slopes
-                    float oscSlope = m_grainData[g].oscFreq * m_sampleDur;
-                    float modSlope = m_grainData[g].modFreq * m_sampleDur;
-                    float envSlope = static_cast<float>(m_allocator.localSlopes[g]);
- 
-                    // Derive osc and mod phases from sample count
-                    float oscPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(oscSlope)));
-                    float modPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(modSlope)));
- 
-                    // Phase increment distortion ratios
-                    float phsIncRatioOsc = 0.0f;
-                    float phsIncRatioMod = 0.0f;
-                    if (sc_abs(envSlope) > Utils::SAFE_DENOM_EPSILON) {
-                        phsIncRatioOsc = sc_abs(oscSlope / envSlope);
-                        phsIncRatioMod = sc_abs(modSlope / envSlope);
-                    }
 
-                    // Apply Phase increment distortion
-                    float phsIncDistOsc = Easing::Interp::jCurve(m_allocator.phases[g], m_grainData[g].warpOsc, Easing::Cores::cubic) - m_allocator.phases[g];
-                    float oscPhaseDistorted = sc_frac(oscPhase + (phsIncDistOsc * phsIncRatioOsc));
- 
-                    float phsIncDistMod = Easing::Interp::jCurve(m_allocator.phases[g], m_grainData[g].warpMod, Easing::Cores::cubic) - m_allocator.phases[g];
-                    float modPhaseDistorted = sc_frac(modPhase + (phsIncDistMod * phsIncRatioMod));
- 
-                    // Calculate mipmap parameters for osc (use ceil for no oversampling)
-                    float oscRangeSize = static_cast<float>(oscCycleSamples);
-                    float oscSamplesPerFrame = std::abs(oscSlope) * oscRangeSize;
-                    float oscOctave = sc_max(0.0f, sc_log2(oscSamplesPerFrame));
-                    int oscLayer = static_cast<int>(sc_ceil(oscOctave));
- 
-                    // Calculate spacings for adjacent mipmap levels for osc
-                    int oscSpacing1 = 1 << oscLayer;
-                    int oscSpacing2 = oscSpacing1 << 1;
-                    float oscCrossfade = sc_frac(oscOctave);
- 
-                    // Calculate mipmap parameters for mod (use ceil for no oversampling)
-                    float modRangeSize = static_cast<float>(modCycleSamples);
-                    float modSamplesPerFrame = std::abs(modSlope) * modRangeSize;
-                    float modOctave = sc_max(0.0f, sc_log2(modSamplesPerFrame));
-                    int modLayer = static_cast<int>(sc_ceil(modOctave));
- 
-                    // Calculate spacings for adjacent mipmap levels for mod
-                    int modSpacing1 = 1 << modLayer;
-                    int modSpacing2 = modSpacing1 << 1;
-                    float modCrossfade = sc_frac(modOctave);
- 
-                    // Process cross-modulated dual oscillator
-                    auto result = m_dualOscs[g].process(
-                        oscPhaseDistorted, modPhaseDistorted,
-                        oscCyclePosVal, modCyclePosVal,
-                        oscSlope, modSlope,
-                        m_grainData[g].pmIndexOsc, m_grainData[g].pmIndexMod,
-                        m_grainData[g].pmFilterRatioOsc, m_grainData[g].pmFilterRatioMod,
-                        oscSpacing1, oscSpacing2, oscCrossfade,
-                        modSpacing1, modSpacing2, modCrossfade,
-                        oscTable.data, oscCycleSamples, oscNumCycles,
-                        modTable.data, modCycleSamples, modNumCycles
-                    );
- 
-                    // Process gaussian window
-                    float grainWindow = WindowFunctions::gaussianWindow(
-                        m_allocator.phases[g], skewVal, indexVal);
- 
-                    // Accumulate grain output
-                    sum += result.oscA * grainWindow;
- 
-                    // Increment sample count
-                    m_grainData[g].sampleCount++;
-                }
-            }
- 
-            // 3. DC block output
-            output[i] = m_dcBlocker.processHighpass(sum, 3.0f, m_sampleRate);
-        }
-    } else {
- 
-        for (int i = 0; i < nSamples; ++i) {
- 
-            // Trigger input (audio-rate or control-rate)
-            bool trigger = isTriggerAudioRate ?
-                m_trigger.process(in(Trigger)[i]) :
-                m_trigger.process(in0(Trigger));
- 
-            // Get current parameter values (no interpolation - latched per trigger)
-            float triggerFreq = isTriggerFreqAudioRate ?
-                sc_clip(in(TriggerFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(TriggerFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float offset = isSubSampleOffsetAudioRate ?
-                in(SubSampleOffset)[i] :
-                in0(SubSampleOffset);
- 
-            float oscFreq = isOscFreqAudioRate ?
+    // Scheduler inputs, a zero stride repeats the control-rate value without a per-sample rate check
+    const float* triggerIn = in(Trigger);
+    const float* triggerFreqIn = in(TriggerFreq);
+    const float* offsetIn = in(SubSampleOffset);
+    const int triggerStride = isTriggerAudioRate ? 1 : 0;
+    const int triggerFreqStride = isTriggerFreqAudioRate ? 1 : 0;
+    const int offsetStride = isSubSampleOffsetAudioRate ? 1 : 0;
+
+    // 1. Resolve trigger events and per-sample parameters for the whole block
+    int numEvents = 0;
+
+    // Voices live at block start or triggered within it
+    EventUtils::VoiceMask<NumVoices> liveVoices = voices.allocator.active;
+
+    for (int i = 0; i < nSamples; ++i) {
+
+        // Trigger input (audio-rate or control-rate)
+        bool trigger = m_trigger.process(triggerIn[i * triggerStride]);
+
+        // Get current parameter values (no interpolation - latched per trigger)
+        float triggerFreq = sc_clip(triggerFreqIn[i * triggerFreqStride], m_sampleRate * -0.49f, m_sampleRate * 0.49f);
+        float offset = offsetIn[i * offsetStride];
+
+        // Get current parameter values (audio-rate or interpolated control-rate)
+        float oscCyclePosVal = (AudioRateInputs && isOscCyclePosAudioRate) ?
+            sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
+            slopedOscCyclePos.consume();
+
+        float modCyclePosVal = (AudioRateInputs && isModCyclePosAudioRate) ?
+            sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
+            slopedModCyclePos.consume();
+
+        float skewVal = (AudioRateInputs && isSkewAudioRate) ?
+            sc_clip(in(Skew)[i], 0.0f, 1.0f) :
+            slopedSkew.consume();
+
+        float indexVal = (AudioRateInputs && isIndexAudioRate) ?
+            sc_clip(in(Index)[i], 0.0f, 10.0f) :
+            slopedIndex.consume();
+
+        // Store parameter values (upsampled after the event pass when oversampling)
+        m_oscCyclePosBlock[i] = oscCyclePosVal;
+        m_modCyclePosBlock[i] = modCyclePosVal;
+        m_skewBlock[i] = skewVal;
+        m_indexBlock[i] = indexVal;
+
+        // Process voice allocation and record the event for the allocated voice
+        int voice = voices.allocator.process(
+            trigger,
+            triggerFreq,
+            offset,
+            m_sampleRate
+        );
+
+        if (voice >= 0) {
+            float oscFreq = (AudioRateInputs && isOscFreqAudioRate) ?
                 sc_clip(in(OscFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(OscFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float modFreq = isModFreqAudioRate ?
+                controlOscFreq;
+
+            float modFreq = (AudioRateInputs && isModFreqAudioRate) ?
                 sc_clip(in(ModFreq)[i], m_sampleRate * -0.49f, m_sampleRate * 0.49f) :
-                sc_clip(in0(ModFreq), m_sampleRate * -0.49f, m_sampleRate * 0.49f);
- 
-            float pmIndexOsc = isPmIndexOscAudioRate ?
+                controlModFreq;
+
+            GrainEvent& event = m_events[numEvents++];
+            event.sample = i;
+            event.voice = voice;
+            liveVoices.set(voice);
+            event.offset = offset;
+            event.oscSlope = oscFreq * m_sampleDur;
+            event.modSlope = modFreq * m_sampleDur;
+            event.envSlope = voices.allocator.localSlopes[voice];
+
+            event.pmIndexOsc = (AudioRateInputs && isPmIndexOscAudioRate) ?
                 sc_clip(in(PmIndexOsc)[i], 0.0f, 10.0f) :
-                sc_clip(in0(PmIndexOsc), 0.0f, 10.0f);
- 
-            float pmIndexMod = isPmIndexModAudioRate ?
+                controlPmIndexOsc;
+
+            event.pmIndexMod = (AudioRateInputs && isPmIndexModAudioRate) ?
                 sc_clip(in(PmIndexMod)[i], 0.0f, 10.0f) :
-                sc_clip(in0(PmIndexMod), 0.0f, 10.0f);
- 
-            float pmFilterRatioOsc = isPmFilterRatioOscAudioRate ?
+                controlPmIndexMod;
+
+            event.pmFilterRatioOsc = (AudioRateInputs && isPmFilterRatioOscAudioRate) ?
                 sc_clip(in(PmFilterRatioOsc)[i], 1.0f, 10.0f) :
-                sc_clip(in0(PmFilterRatioOsc), 1.0f, 10.0f);
- 
-            float pmFilterRatioMod = isPmFilterRatioModAudioRate ?
+                controlPmFilterRatioOsc;
+
+            event.pmFilterRatioMod = (AudioRateInputs && isPmFilterRatioModAudioRate) ?
                 sc_clip(in(PmFilterRatioMod)[i], 1.0f, 10.0f) :
-                sc_clip(in0(PmFilterRatioMod), 1.0f, 10.0f);
- 
-            float warpOsc = isWarpOscAudioRate ?
+                controlPmFilterRatioMod;
+
+            event.warpOsc = (AudioRateInputs && isWarpOscAudioRate) ?
                 sc_clip(in(WarpOsc)[i], 0.0f, 1.0f) :
-                sc_clip(in0(WarpOsc), 0.0f, 1.0f);
- 
-            float warpMod = isWarpModAudioRate ?
+                controlWarpOsc;
+
+            event.warpMod = (AudioRateInputs && isWarpModAudioRate) ?
                 sc_clip(in(WarpMod)[i], 0.0f, 1.0f) :
-                sc_clip(in0(WarpMod), 0.0f, 1.0f);
- 
-            // Get current parameter values (audio-rate or interpolated control-rate)
-            float oscCyclePosVal = isOscCyclePosAudioRate ?
-                sc_clip(in(OscCyclePos)[i], 0.0f, 1.0f) :
-                slopedOscCyclePos.consume();
- 
-            float modCyclePosVal = isModCyclePosAudioRate ?
-                sc_clip(in(ModCyclePos)[i], 0.0f, 1.0f) :
-                slopedModCyclePos.consume();
- 
-            float skewVal = isSkewAudioRate ?
-                sc_clip(in(Skew)[i], 0.0f, 1.0f) :
-                slopedSkew.consume();
- 
-            float indexVal = isIndexAudioRate ?
-                sc_clip(in(Index)[i], 0.0f, 10.0f) :
-                slopedIndex.consume();
- 
-            // 1. Process voice allocation
-            m_allocator.process(
-                trigger,
-                triggerFreq,
-                offset,
-                m_sampleRate
-            );
- 
-            // 2. Upsample parameter values
-            m_oscCyclePosOversampling.upsample(oscCyclePosVal);
-            m_modCyclePosOversampling.upsample(modCyclePosVal);
-            m_skewOversampling.upsample(skewVal);
-            m_indexOversampling.upsample(indexVal);
- 
-            // 3. Clear OS buffer
-            memset(m_outputOSBuffer, 0, m_osRatio * sizeof(float));
- 
-            // 4. Process all grains
-            for (int g = 0; g < NUM_VOICES; ++g) {
- 
-                // Trigger new grain if needed and store graindata
-                if (m_allocator.triggers[g]) {
-                    m_grainData[g].oscFreq = oscFreq;
-                    m_grainData[g].modFreq = modFreq;
-                    m_grainData[g].pmIndexOsc = pmIndexOsc;
-                    m_grainData[g].pmIndexMod = pmIndexMod;
-                    m_grainData[g].pmFilterRatioOsc = pmFilterRatioOsc;
-                    m_grainData[g].pmFilterRatioMod = pmFilterRatioMod;
-                    m_grainData[g].warpOsc = warpOsc;
-                    m_grainData[g].warpMod = warpMod;
-                    m_grainData[g].sampleCount = offset;
-                    m_dualOscs[g].reset();
-                }
- 
-                // Process grain if voice is active
-                if (m_allocator.isActive[g]) {
- 
-                    // Calculate slopes
-                    float oscSlope = m_grainData[g].oscFreq * m_sampleDur;
-                    float modSlope = m_grainData[g].modFreq * m_sampleDur;
-                    float envSlope = static_cast<float>(m_allocator.localSlopes[g]);
- 
-                    // Derive osc and mod phases from sample count
-                    float oscPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(oscSlope)));
-                    float modPhase = static_cast<float>(sc_frac(m_grainData[g].sampleCount * static_cast<double>(modSlope)));
- 
-                    // Calculate mipmap parameters for osc (use floor for oversampling)
-                    float oscRangeSize = static_cast<float>(oscCycleSamples);
-                    float oscSamplesPerFrame = std::abs(oscSlope) * oscRangeSize;
-                    float oscOctave = sc_max(0.0f, sc_log2(oscSamplesPerFrame));
-                    int oscLayer = static_cast<int>(sc_floor(oscOctave));
- 
-                    // Calculate spacings for adjacent mipmap levels for osc
-                    int oscSpacing1 = 1 << oscLayer;
-                    int oscSpacing2 = oscSpacing1 << 1;
-                    float oscCrossfade = sc_frac(oscOctave);
- 
-                    // Calculate mipmap parameters for mod (use floor for oversampling)
-                    float modRangeSize = static_cast<float>(modCycleSamples);
-                    float modSamplesPerFrame = std::abs(modSlope) * modRangeSize;
-                    float modOctave = sc_max(0.0f, sc_log2(modSamplesPerFrame));
-                    int modLayer = static_cast<int>(sc_floor(modOctave));
- 
-                    // Calculate spacings for adjacent mipmap levels for mod
-                    int modSpacing1 = 1 << modLayer;
-                    int modSpacing2 = modSpacing1 << 1;
-                    float modCrossfade = sc_frac(modOctave);
- 
-                    // Initialize osc phase and slope for oversampling
-                    float osOscSlope = oscSlope / static_cast<float>(m_osRatio);
-                    float osOscPhase = oscPhase - oscSlope;
- 
-                    // Initialize mod phase and slope for oversampling
-                    float osModSlope = modSlope / static_cast<float>(m_osRatio);
-                    float osModPhase = modPhase - modSlope;
- 
-                    // Initialize env phase and slope for oversampling
-                    float osEnvSlope = envSlope / static_cast<float>(m_osRatio);
-                    float osEnvPhase = m_allocator.phases[g] - envSlope;
- 
-                    // Phase increment distortion ratios
-                    float phsIncRatioOsc = 0.0f;
-                    float phsIncRatioMod = 0.0f;
-                    if (sc_abs(envSlope) > Utils::SAFE_DENOM_EPSILON) {
-                        phsIncRatioOsc = sc_abs(oscSlope / envSlope);
-                        phsIncRatioMod = sc_abs(modSlope / envSlope);
-                    }
- 
-                    for (int k = 0; k < m_osRatio; k++) {
- 
-                        // Clamp upsampled values
-                        m_oscCyclePosOSBuffer[k] = sc_clip(m_oscCyclePosOSBuffer[k], 0.0f, 1.0f);
-                        m_modCyclePosOSBuffer[k] = sc_clip(m_modCyclePosOSBuffer[k], 0.0f, 1.0f);
-                        m_skewOSBuffer[k] = sc_clip(m_skewOSBuffer[k], 0.0f, 1.0f);
-                        m_indexOSBuffer[k] = sc_clip(m_indexOSBuffer[k], 0.0f, 10.0f);
- 
-                        // Increment oversampled phases
-                        osOscPhase += osOscSlope;
-                        osModPhase += osModSlope;
-                        osEnvPhase += osEnvSlope;
- 
-                        // Apply phase increment distortion
-                        float phsIncDistOsc = Easing::Interp::jCurve(osEnvPhase, m_grainData[g].warpOsc, Easing::Cores::cubic) - osEnvPhase;
-                        float osOscPhaseDistorted = sc_frac(osOscPhase + (phsIncDistOsc * phsIncRatioOsc));
- 
-                        float phsIncDistMod = Easing::Interp::jCurve(osEnvPhase, m_grainData[g].warpMod, Easing::Cores::cubic) - osEnvPhase;
-                        float osModPhaseDistorted = sc_frac(osModPhase + (phsIncDistMod * phsIncRatioMod));
- 
-                        // Process cross-modulated dual oscillator at oversampled rate
-                        auto result = m_dualOscs[g].process(
-                            osOscPhaseDistorted, osModPhaseDistorted,
-                            m_oscCyclePosOSBuffer[k], m_modCyclePosOSBuffer[k],
-                            osOscSlope, osModSlope,
-                            m_grainData[g].pmIndexOsc, m_grainData[g].pmIndexMod,
-                            m_grainData[g].pmFilterRatioOsc, m_grainData[g].pmFilterRatioMod,
-                            oscSpacing1, oscSpacing2, oscCrossfade,
-                            modSpacing1, modSpacing2, modCrossfade,
-                            oscTable.data, oscCycleSamples, oscNumCycles,
-                            modTable.data, modCycleSamples, modNumCycles
-                        );
- 
-                        // Process gaussian window with upsampled skew and index
-                        float grainWindow = WindowFunctions::gaussianWindow(
-                            osEnvPhase, m_skewOSBuffer[k], m_indexOSBuffer[k]);
- 
-                        // Accumulate grain output
-                        m_outputOSBuffer[k] += result.oscA * grainWindow;
-                    }
- 
-                    // Increment sample count
-                    m_grainData[g].sampleCount++;
-                }
-            }
- 
-            // 5. Downsample and DC block output
-            output[i] = m_dcBlocker.processHighpass(m_outputOversampling.downsample(), 3.0f, m_sampleRate);
+                controlWarpMod;
+        }
+
+        if (m_overflowOutput) {
+            m_overflowBlock[i] = static_cast<float>(voices.allocator.overflowCount);
         }
     }
- 
-    // Update parameter cache (use last value if audio-rate, otherwise slope value)
+
+    // Update parameter cache before writing output, which may alias the inputs
     oscCyclePosPast = isOscCyclePosAudioRate ?
         sc_clip(in(OscCyclePos)[nSamples - 1], 0.0f, 1.0f) : slopedOscCyclePos.value;
- 
+
     modCyclePosPast = isModCyclePosAudioRate ?
         sc_clip(in(ModCyclePos)[nSamples - 1], 0.0f, 1.0f) : slopedModCyclePos.value;
- 
+
     skewPast = isSkewAudioRate ?
         sc_clip(in(Skew)[nSamples - 1], 0.0f, 1.0f) : slopedSkew.value;
- 
+
     indexPast = isIndexAudioRate ?
         sc_clip(in(Index)[nSamples - 1], 0.0f, 10.0f) : slopedIndex.value;
+
+    // Pick this block's ratio from the fastest grain and the deepest phase modulation
+    if (m_autoOversample) {
+        float maxSlope = 0.0f;
+        float maxModIndex = 0.0f;
+        for (int g : liveVoices) {
+            const GrainData& grain = voices.grainData[g];
+            if (grain.active) {
+                maxSlope = sc_max(maxSlope, sc_max(sc_abs(grain.oscSlope), sc_abs(grain.modSlope)));
+                maxModIndex = sc_max(maxModIndex, sc_max(grain.pmIndexOsc, grain.pmIndexMod));
+            }
+        }
+        for (int e = 0; e < numEvents; ++e) {
+            const GrainEvent& event = m_events[e];
+            maxSlope = sc_max(maxSlope, sc_max(sc_abs(event.oscSlope), sc_abs(event.modSlope)));
+            maxModIndex = sc_max(maxModIndex, sc_max(event.pmIndexOsc, event.pmIndexMod));
+        }
+        setOversampleIndex(m_adaptiveRatio.process(maxSlope, maxModIndex));
+    }
+
+    const bool oversampled = m_oversampleIndex > 0;
+
+    // Upsample all parameter values in one pass, control-rate values are ramped
+    if (oversampled) {
+        m_paramOversampling.upsampleBlock({
+            m_oscCyclePosBlock, m_modCyclePosBlock, m_skewBlock, m_indexBlock
+        }, nSamples);
+
+        // Only the half-band path for audio-rate values can overshoot the parameter range
+        if (m_paramOversampling.filtered()) {
+            for (int k = 0; k < nSamples * m_osRatio; k++) {
+                m_oscCyclePosBlock[k] = sc_clip(m_oscCyclePosBlock[k], 0.0f, 1.0f);
+                m_modCyclePosBlock[k] = sc_clip(m_modCyclePosBlock[k], 0.0f, 1.0f);
+                m_skewBlock[k] = sc_clip(m_skewBlock[k], 0.0f, 1.0f);
+                m_indexBlock[k] = sc_clip(m_indexBlock[k], 0.0f, 10.0f);
+            }
+        }
+    }
+
+    // 2. Render each voice across its live span of the block
+    memset(m_outputBlock, 0, nSamples * m_osRatio * sizeof(float));
+
+    // Stolen grains still fading out from previous blocks
+    for (int g : voices.fading) {
+        if (!renderTail<Interpolator>(voices.tails[g], oscTable, modTable, 0, nSamples)) {
+            voices.fading.clear(g);
+        }
+    }
+
+    for (int g : liveVoices) {
+
+        GrainData& grain = voices.grainData[g];
+        int eventIndex = 0;
+        int i = 0;
+
+        while (i < nSamples) {
+
+            // The next trigger event of this voice bounds the current span
+            int eventSample = EventUtils::nextVoiceEvent(m_events, numEvents, g, eventIndex, nSamples);
+
+            if (i == eventSample) {
+
+                // Stolen voice: hand the running grain over to a short fade-out
+                if (grain.active) {
+                    GrainTail& tail = voices.tails[g];
+                    tail.grain = grain;
+                    tail.dualOsc = voices.dualOscs[g];
+                    tail.remaining = m_stealFadeSamples;
+                    if (renderTail<Interpolator>(tail, oscTable, modTable, i, nSamples)) {
+                        voices.fading.set(g);
+                    } else {
+                        voices.fading.clear(g);
+                    }
+                }
+
+                // Store graindata of the triggered grain
+                const GrainEvent& event = m_events[eventIndex++];
+
+                grain.pmIndexOsc = event.pmIndexOsc;
+                grain.pmIndexMod = event.pmIndexMod;
+                grain.pmFilterRatioOsc = event.pmFilterRatioOsc;
+                grain.pmFilterRatioMod = event.pmFilterRatioMod;
+                grain.warpOsc = event.warpOsc;
+                grain.warpMod = event.warpMod;
+                grain.sampleCount = event.offset;
+                voices.dualOscs[g].reset();
+
+                // Latch slopes for the lifetime of the grain
+                grain.oscSlope = event.oscSlope;
+                grain.modSlope = event.modSlope;
+                grain.envSlope = event.envSlope;
+                grain.envPhase = event.envSlope * event.offset;
+                grain.active = true;
+
+                // Phase increment distortion ratios
+                const float envSlope = static_cast<float>(grain.envSlope);
+                grain.phsIncRatioOsc = 0.0f;
+                grain.phsIncRatioMod = 0.0f;
+                if (sc_abs(envSlope) > Utils::SAFE_DENOM_EPSILON) {
+                    grain.phsIncRatioOsc = sc_abs(grain.oscSlope / envSlope);
+                    grain.phsIncRatioMod = sc_abs(grain.modSlope / envSlope);
+                }
+
+                // Latch mipmap parameters (use floor for oversampling, ceil otherwise)
+                grain.oscLevel = OscUtils::mipmapLevel(grain.oscSlope, oscTable.cycleSamples, oversampled);
+                grain.modLevel = OscUtils::mipmapLevel(grain.modSlope, modTable.cycleSamples, oversampled);
+
+                eventSample = EventUtils::nextVoiceEvent(m_events, numEvents, g, eventIndex, nSamples);
+
+            } else if (!grain.active) {
+
+                // Idle voice: jump to its next trigger event
+                i = eventSample;
+                continue;
+            }
+
+            i = renderGrain<Interpolator>(
+                grain, voices.dualOscs[g], oscTable, modTable,
+                i, eventSample, 1.0f, 0.0f
+            );
+        }
+    }
+
+    // 3. Downsample and DC block output, in auto mode also at 1x to glide out a ratio change
+    if (oversampled || m_autoOversample) {
+        m_outputOversampling.downsampleBlock(m_outputBlock, m_outputBlock, nSamples);
+    }
+    for (int i = 0; i < nSamples; ++i) {
+        output[i] = m_dcBlocker.processHighpass(m_outputBlock[i], 3.0f, m_sampleRate);
+    }
+
+    // 4. Running count of triggers which found all voices busy
+    if (m_overflowOutput) {
+        memcpy(out(Overflow), m_overflowBlock, nSamples * sizeof(float));
+    }
+}
+
+void DualPulsarOS::setOversampleIndex(int index) {
+    m_oversampleIndex = index;
+    m_osRatio = 1 << index;
+    m_outputOversampling.setRatio(m_osRatio);
+    m_paramOversampling.setRatio(m_osRatio);
+}
+
+// ===== WAVETABLE PREPARATION COMMAND =====
+
+struct PrepareWavetableCmdData {
+    int bufnum;
+    int numCycles;
+    OscUtils::WavetableRegistry* registry;
+    OscUtils::PreparedWavetable* prepared;
+    OscUtils::PreparedWavetable** slots;
+    OscUtils::PreparedWavetable** released;
+    int numReleased;
+};
+
+// NRT thread: free what has not been handed over to the registry
+void freeWavetableCmdData(PrepareWavetableCmdData* data) {
+    NRTFree(data->prepared);
+    NRTFree(data->slots);
+    NRTFree(data->released);
+    data->prepared = nullptr;
+    data->slots = nullptr;
+    data->released = nullptr;
+}
+
+// Stage 2 (NRT thread): build mipmap levels from the buffer, a release command only allocates the release list
+bool cmdWavetableStage2(World* world, void* inData, bool build) {
+    auto* data = static_cast<PrepareWavetableCmdData*>(inData);
+    const char* cmdName = build ? "prepareWavetable" : "releaseWavetable";
+
+    if (data->bufnum < 0 || data->bufnum >= static_cast<int>(world->mNumSndBufs)) {
+        Print("%s: invalid buffer number %d\n", cmdName, data->bufnum);
+        return false;
+    }
+
+    data->registry = OscUtils::wavetableRegistry(world, true);
+    if (!data->registry) {
+        Print("%s: too many servers\n", cmdName);
+        return false;
+    }
+
+    // Every slot can be released in stage 3, see cmdWavetableStage3
+    const size_t slotsSize = world->mNumSndBufs * sizeof(OscUtils::PreparedWavetable*);
+    data->released = static_cast<OscUtils::PreparedWavetable**>(NRTAlloc(slotsSize));
+    if (!data->released) {
+        Print("%s: memory allocation failed\n", cmdName);
+        return false;
+    }
+
+    // Allocate registry slots on first use
+    if (!data->registry->m_slots.load()) {
+        data->slots = static_cast<OscUtils::PreparedWavetable**>(NRTAlloc(slotsSize));
+        if (!data->slots) {
+            Print("%s: memory allocation failed\n", cmdName);
+            freeWavetableCmdData(data);
+            return false;
+        }
+        memset(data->slots, 0, slotsSize);
+    }
+
+    if (!build) {
+        return true;
+    }
+
+    SndBuf* buf = World_GetNRTBuf(world, data->bufnum);
+    if (buf->data && buf->samples % data->numCycles != 0) {
+        Print("prepareWavetable: buffer %d size is not a multiple of %d cycles\n", data->bufnum, data->numCycles);
+        freeWavetableCmdData(data);
+        return false;
+    }
+    const int cycleSamples = buf->data ? buf->samples / data->numCycles : 0;
+    if (OscUtils::MipmapPyramid::countLevels(cycleSamples) == 0) {
+        Print("prepareWavetable: buffer %d needs a power-of-2 number of samples per cycle\n", data->bufnum);
+        freeWavetableCmdData(data);
+        return false;
+    }
+
+    void* memory = NRTAlloc(OscUtils::PreparedWavetable::allocSize(data->numCycles, cycleSamples));
+    if (!memory) {
+        Print("prepareWavetable: memory allocation failed\n");
+        freeWavetableCmdData(data);
+        return false;
+    }
+    auto* prepared = new (memory) OscUtils::PreparedWavetable{};
+
+    prepared->sourceData = buf->data;
+    prepared->sourceSize = data->numCycles * cycleSamples;
+    prepared->numCycles = data->numCycles;
+    prepared->pyramid.build(buf->data, data->numCycles, cycleSamples, prepared->storage());
+    memcpy(prepared->snapshot(), buf->data, prepared->sourceSize * sizeof(float));
+
+    data->prepared = prepared;
+    return true;
+}
+
+bool cmdPrepareWavetableStage2(World* world, void* inData) {
+    return cmdWavetableStage2(world, inData, true);
+}
+
+bool cmdReleaseWavetableStage2(World* world, void* inData) {
+    return cmdWavetableStage2(world, inData, false);
+}
+
+// Stage 3 (RT thread): swap prepared levels into the registry (none for a release) and release the levels
+// of buffers that have been freed or reallocated since they were prepared
+bool cmdWavetableStage3(World* world, void* inData) {
+    auto* data = static_cast<PrepareWavetableCmdData*>(inData);
+    OscUtils::WavetableRegistry* registry = data->registry;
+
+    // Publish slots allocated in stage 2, unless another command already did
+    if (data->slots && !registry->m_slots.load()) {
+        registry->m_numSlots = static_cast<int>(world->mNumSndBufs);
+        registry->m_slots.store(data->slots);
+        data->slots = nullptr;
+    }
+
+    OscUtils::PreparedWavetable** slots = registry->m_slots.load();
+    const int numSlots = sc_min(registry->m_numSlots, static_cast<int>(world->mNumSndBufs));
+    for (int bufnum = 0; bufnum < numSlots; ++bufnum) {
+        OscUtils::PreparedWavetable* entry = slots[bufnum];
+        if (!entry) {
+            continue;
+        }
+        const SndBuf* buf = world->mSndBufs + bufnum;
+        if (bufnum == data->bufnum || buf->data != entry->sourceData || buf->samples != entry->sourceSize) {
+            data->released[data->numReleased++] = entry;
+            slots[bufnum] = nullptr;
+        }
+    }
+
+    if (data->prepared && data->bufnum < numSlots) {
+        slots[data->bufnum] = data->prepared;
+        data->prepared = nullptr;
+    }
+
+    // Units look up the registry again on their next block
+    registry->m_generation++;
+    return true;
+}
+
+// Stage 4 (NRT thread): free replaced and released levels and unused slots
+bool cmdWavetableStage4(World* world, void* inData) {
+    auto* data = static_cast<PrepareWavetableCmdData*>(inData);
+
+    for (int i = 0; i < data->numReleased; ++i) {
+        NRTFree(data->released[i]);
+    }
+    data->numReleased = 0;
+    freeWavetableCmdData(data);
+    return true;
+}
+
+void cmdWavetableCleanup(World* world, void* inData) {
+    RTFree(world, inData);
+}
+
+void cmdWavetable(World* world, struct sc_msg_iter* args, void* replyAddr, bool build) {
+    const char* cmdName = build ? "prepareWavetable" : "releaseWavetable";
+
+    auto* data = static_cast<PrepareWavetableCmdData*>(RTAlloc(world, sizeof(PrepareWavetableCmdData)));
+    if (!data) {
+        Print("%s: memory allocation failed\n", cmdName);
+        return;
+    }
+
+    data->bufnum = args->geti();
+    data->numCycles = build ? sc_max(args->geti(1), 1) : 1;
+    data->registry = nullptr;
+    data->prepared = nullptr;
+    data->slots = nullptr;
+    data->released = nullptr;
+    data->numReleased = 0;
+
+    // Optional completion message, freed by the server
+    int msgSize = args->getbsize();
+    char* msgData = nullptr;
+    if (msgSize) {
+        msgData = static_cast<char*>(RTAlloc(world, msgSize));
+        args->getb(msgData, msgSize);
+    }
+
+    DoAsynchronousCommand(world, replyAddr, cmdName, data,
+        build ? cmdPrepareWavetableStage2 : cmdReleaseWavetableStage2, cmdWavetableStage3, cmdWavetableStage4,
+        cmdWavetableCleanup, msgSize, msgData);
+}
+
+void cmdPrepareWavetable(World* world, void* inUserData, struct sc_msg_iter* args, void* replyAddr) {
+    cmdWavetable(world, args, replyAddr, true);
+}
+
+void cmdReleaseWavetable(World* world, void* inUserData, struct sc_msg_iter* args, void* replyAddr) {
+    cmdWavetable(world, args, replyAddr, false);
+}
+
+// Plugin unload: no server of this process is running any more, free the prepared levels of all of them
+void releaseWavetables() {
+    OscUtils::releaseWavetableRegistries();
 }
 
 void Oscs_setup()
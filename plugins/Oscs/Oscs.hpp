@@ -15,26 +15,38 @@ public:
     ~SingleOscOS();
     
 private:
+    template<typename Interpolator>
+    void setCalcFunction();
+    template<typename Interpolator, bool AudioRateInputs>
     void next(int nSamples);
+    void setOversampleIndex(int index);
     
     // Constants cached at construction
     const float m_sampleRate;
-    const int m_oversampleIndex;
-    const int m_osRatio;
+    const bool m_autoOversample;
+    const bool m_latencyOutput;
+
+    // Oversampling ratio, picked per block in auto mode
+    int m_oversampleIndex;
+    int m_osRatio;
     
     // Core processing
     EventUtils::RampToSlope m_rampToSlope;
 
     // Buffer units
-    PluginUtils::BufUnit m_oscBufUnit;
+    OscUtils::WavetableBufUnit m_oscBufUnit;
     
     // Oversampling objects
     OversamplingUtils::VariableOversampling m_outputOversampling;
-    OversamplingUtils::VariableOversampling m_cyclePosOversampling;
+    OversamplingUtils::MultiChannelOversampling<1> m_paramOversampling;
+    OversamplingUtils::AdaptiveRatio m_adaptiveRatio;
 
-    // Stored oversampling state
+    // Stored oversampling state, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
     float* m_outputOSBuffer{nullptr};
     float* m_cyclePosOSBuffer{nullptr};
+    float* m_phaseBlock{nullptr};
+    float* m_slopeBlock{nullptr};
     
     // Cache for SlopeSignal state
     float cyclePosPast;
@@ -47,11 +59,15 @@ private:
         Phase,
         NumCycles,
         CyclePos,
-        Oversample
+        Oversample,
+        Interp,
+        FilterDesign,
+        LatencyOutput
     };
     
     enum Outputs { 
-        Out
+        Out,
+        Latency
     };
 };
 
@@ -63,12 +79,20 @@ public:
     ~DualOscOS();
     
 private:
+    template<typename Interpolator>
+    void setCalcFunction();
+    template<typename Interpolator, bool AudioRateInputs>
     void next(int nSamples);
+    void setOversampleIndex(int index);
     
     // Constants cached at construction
     const float m_sampleRate;
-    const int m_oversampleIndex;
-    const int m_osRatio;
+    const bool m_autoOversample;
+    const bool m_latencyOutput;
+
+    // Oversampling ratio, picked per block in auto mode
+    int m_oversampleIndex;
+    int m_osRatio;
     
     // Core processing
     EventUtils::RampToSlope m_rampToSlopeA;
@@ -76,20 +100,17 @@ private:
     OscUtils::DualOsc m_dualOsc;
 
     // Buffer units
-    PluginUtils::BufUnit m_oscBufUnitA;
-    PluginUtils::BufUnit m_oscBufUnitB;
+    OscUtils::WavetableBufUnit m_oscBufUnitA;
+    OscUtils::WavetableBufUnit m_oscBufUnitB;
     
     // Oversampling objects
     OversamplingUtils::VariableOversampling m_outputOversamplingA;
     OversamplingUtils::VariableOversampling m_outputOversamplingB;
-    OversamplingUtils::VariableOversampling m_cyclePosAOversampling;
-    OversamplingUtils::VariableOversampling m_cyclePosBOversampling;
-    OversamplingUtils::VariableOversampling m_pmIndexAOversampling;
-    OversamplingUtils::VariableOversampling m_pmIndexBOversampling;
-    OversamplingUtils::VariableOversampling m_pmFilterRatioAOversampling;
-    OversamplingUtils::VariableOversampling m_pmFilterRatioBOversampling;
+    OversamplingUtils::MultiChannelOversampling<6> m_paramOversampling;
+    OversamplingUtils::AdaptiveRatio m_adaptiveRatio;
     
-    // Stored oversampling state
+    // Stored oversampling state, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
     float* m_outputOSBufferA{nullptr};
     float* m_outputOSBufferB{nullptr};
     float* m_cyclePosAOSBuffer{nullptr};
@@ -98,6 +119,10 @@ private:
     float* m_pmIndexBOSBuffer{nullptr};
     float* m_pmFilterRatioAOSBuffer{nullptr};
     float* m_pmFilterRatioBOSBuffer{nullptr};
+    float* m_phaseABlock{nullptr};
+    float* m_phaseBBlock{nullptr};
+    float* m_slopeABlock{nullptr};
+    float* m_slopeBBlock{nullptr};
         
     // Cache for SlopeSignal state
     float cyclePosAPast;
@@ -131,12 +156,16 @@ private:
         PMFilterRatioA, 
         PMFilterRatioB,
         
-        Oversample
+        Oversample,
+        Interp,
+        FilterDesign,
+        LatencyOutput
     };
     
     enum Outputs { 
         OutA, 
-        OutB    
+        OutB,
+        Latency
     };
 };
 
@@ -148,49 +177,111 @@ public:
     ~PulsarOS();
     
 private:
+    template<typename Interpolator>
+    void setCalcFunction();
+    template<typename Interpolator, int NumVoices>
+    void setVoiceCalcFunction();
+    template<typename Interpolator, bool AudioRateInputs, int NumVoices>
     void next(int nSamples);
-    
-    // Constants
-    static constexpr int NUM_VOICES = 16;
+    void setOversampleIndex(int index);
+
     
     // Constants cached at construction
     const float m_sampleRate;
     const float m_sampleDur;
-    const int m_oversampleIndex;
-    const int m_osRatio;
+    const bool m_autoOversample;
+
+    // Oversampling ratio, picked per block in auto mode
+    int m_oversampleIndex;
+    int m_osRatio;
+    const int m_numVoices;
+    const EventUtils::VoicePolicy m_voicePolicy;
+    const int m_stealFadeSamples;
+    const bool m_overflowOutput;
  
     // Core processing
-    EventUtils::VoiceAllocator<NUM_VOICES> m_allocator;
     EventUtils::IsTrigger m_trigger;
-    std::array<FilterUtils::OnePoleSlope, NUM_VOICES> m_pmFilters;
  
     // Buffer units
-    PluginUtils::BufUnit m_oscBufUnit;
-    PluginUtils::BufUnit m_envBufUnit;
-    PluginUtils::BufUnit m_modBufUnit;
+    OscUtils::WavetableBufUnit m_oscBufUnit;
+    OscUtils::WavetableBufUnit m_envBufUnit;
+    OscUtils::WavetableBufUnit m_modBufUnit;
     
     // Oversampling objects
     OversamplingUtils::VariableOversampling m_outputOversampling;
-    OversamplingUtils::VariableOversampling m_oscCyclePosOversampling;
-    OversamplingUtils::VariableOversampling m_envCyclePosOversampling;
-    OversamplingUtils::VariableOversampling m_modCyclePosOversampling;
-
-    // Stored oversampling state
-    float* m_outputOSBuffer{nullptr};
-    float* m_oscCyclePosOSBuffer{nullptr};
-    float* m_envCyclePosOSBuffer{nullptr};
-    float* m_modCyclePosOSBuffer{nullptr};
+    OversamplingUtils::MultiChannelOversampling<3> m_paramOversampling;
+    OversamplingUtils::AdaptiveRatio m_adaptiveRatio;
     
     // Grain data structure
     struct GrainData {
-        float oscFreq = 0.0f;
-        float modFreq = 0.0f;
         float modIndex = 0.0f;
         double sampleCount = 0.0;
+
+        // Slopes and mipmap parameters latched at trigger
+        float oscSlope = 0.0f;
+        float modSlope = 0.0f;
+        double envSlope = 0.0;
+        float modScaleRatio = 0.0f;
+        OscUtils::MipmapLevel oscLevel;
+        OscUtils::MipmapLevel modLevel;
+        OscUtils::MipmapLevel envLevel;
+
+        // Window phase, mirrors the voice allocator across blocks
+        double envPhase = 0.0;
+        bool active = false;
     };
     
-    // Grain voices
-    std::array<GrainData, NUM_VOICES> m_grainData;
+    // Stolen grain fading out while its voice restarts
+    struct GrainTail {
+        GrainData grain;
+        FilterUtils::OnePoleSlope pmFilter;
+        int remaining = 0;
+    };
+    
+    // Grain voices, sized by the voice count selected at construction
+    template<int NumVoices>
+    struct VoiceBank {
+        EventUtils::VoiceAllocator<NumVoices> allocator;
+        std::array<FilterUtils::OnePoleSlope, NumVoices> pmFilters;
+        std::array<GrainData, NumVoices> grainData;
+        std::array<GrainTail, NumVoices> tails;
+        EventUtils::VoiceMask<NumVoices> fading;
+    };
+    void* m_voiceBank{nullptr};
+
+    // Voices and block buffers, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
+
+    // Trigger event resolved by the voice allocator
+    struct GrainEvent {
+        int sample;
+        int voice;
+        float offset;
+        float oscSlope;
+        float modSlope;
+        float modIndex;
+        double envSlope;
+    };
+
+    // Block buffers for voice-major rendering
+    GrainEvent* m_events{nullptr};
+    float* m_oscCyclePosBlock{nullptr};
+    float* m_envCyclePosBlock{nullptr};
+    float* m_modCyclePosBlock{nullptr};
+    float* m_outputBlock{nullptr};
+    float* m_overflowBlock{nullptr};
+
+    // Render a grain from start until end or its window completes, returns the stop sample
+    template<typename Interpolator>
+    int renderGrain(GrainData& grain, FilterUtils::OnePoleSlope& pmFilter,
+        const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& envTable, const OscUtils::Wavetable& modTable,
+        int start, int end, float gain, float gainSlope);
+
+    // Render a stolen grain along its fade-out, returns true while it is still fading
+    template<typename Interpolator>
+    bool renderTail(GrainTail& tail,
+        const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& envTable, const OscUtils::Wavetable& modTable,
+        int start, int end);
     
     // Output processing
     FilterUtils::OnePoleHz m_dcBlocker;
@@ -232,11 +323,16 @@ private:
         ModNumCycles,
         ModCyclePos,
         
-        Oversample
+        Oversample,
+        Interp,
+        MaxVoices,
+        VoicePolicy,
+        VoiceStats
     };
     
     enum Outputs {
-        Out
+        Out,
+        Overflow
     };
 };
 
@@ -248,46 +344,41 @@ public:
     ~DualPulsarOS();
  
 private:
+    template<typename Interpolator>
+    void setCalcFunction();
+    template<typename Interpolator, int NumVoices>
+    void setVoiceCalcFunction();
+    template<typename Interpolator, bool AudioRateInputs, int NumVoices>
     void next(int nSamples);
- 
-    // Constants
-    static constexpr int NUM_VOICES = 16;
+    void setOversampleIndex(int index);
  
     // Constants cached at construction
     const float m_sampleRate;
     const float m_sampleDur;
-    const int m_oversampleIndex;
-    const int m_osRatio;
+    const bool m_autoOversample;
+
+    // Oversampling ratio, picked per block in auto mode
+    int m_oversampleIndex;
+    int m_osRatio;
+    const int m_numVoices;
+    const EventUtils::VoicePolicy m_voicePolicy;
+    const int m_stealFadeSamples;
+    const bool m_overflowOutput;
  
     // Core processing
-    EventUtils::VoiceAllocator<NUM_VOICES> m_allocator;
     EventUtils::IsTrigger m_trigger;
  
-    // Per-voice cross-modulation state
-    std::array<OscUtils::DualOscScaled, NUM_VOICES> m_dualOscs;
- 
     // Buffer units
-    PluginUtils::BufUnit m_oscBufUnit;
-    PluginUtils::BufUnit m_modBufUnit;
+    OscUtils::WavetableBufUnit m_oscBufUnit;
+    OscUtils::WavetableBufUnit m_modBufUnit;
  
     // Oversampling objects
     OversamplingUtils::VariableOversampling m_outputOversampling;
-    OversamplingUtils::VariableOversampling m_oscCyclePosOversampling;
-    OversamplingUtils::VariableOversampling m_modCyclePosOversampling;
-    OversamplingUtils::VariableOversampling m_skewOversampling;
-    OversamplingUtils::VariableOversampling m_indexOversampling;
-
-    // Stored oversampling state
-    float* m_outputOSBuffer{nullptr};
-    float* m_oscCyclePosOSBuffer{nullptr};
-    float* m_modCyclePosOSBuffer{nullptr};
-    float* m_skewOSBuffer{nullptr};
-    float* m_indexOSBuffer{nullptr};
+    OversamplingUtils::MultiChannelOversampling<4> m_paramOversampling;
+    OversamplingUtils::AdaptiveRatio m_adaptiveRatio;
  
     // Grain data structure
     struct GrainData {
-        float oscFreq = 0.0f;
-        float modFreq = 0.0f;
         float pmIndexOsc = 0.0f;
         float pmIndexMod = 0.0f;
         float pmFilterRatioOsc = 1.0f;
@@ -295,8 +386,78 @@ private:
         float warpOsc = 0.5f;
         float warpMod = 0.5f;
         double sampleCount = 0.0;
+
+        // Slopes and mipmap parameters latched at trigger
+        float oscSlope = 0.0f;
+        float modSlope = 0.0f;
+        double envSlope = 0.0;
+        float phsIncRatioOsc = 0.0f;
+        float phsIncRatioMod = 0.0f;
+        OscUtils::MipmapLevel oscLevel;
+        OscUtils::MipmapLevel modLevel;
+
+        // Window phase, mirrors the voice allocator across blocks
+        double envPhase = 0.0;
+        bool active = false;
+    };
+
+    // Stolen grain fading out while its voice restarts
+    struct GrainTail {
+        GrainData grain;
+        OscUtils::DualOscScaled dualOsc;
+        int remaining = 0;
     };
-    std::array<GrainData, NUM_VOICES> m_grainData;
+
+    // Grain voices with per-voice cross-modulation state, sized at construction
+    template<int NumVoices>
+    struct VoiceBank {
+        EventUtils::VoiceAllocator<NumVoices> allocator;
+        std::array<OscUtils::DualOscScaled, NumVoices> dualOscs;
+        std::array<GrainData, NumVoices> grainData;
+        std::array<GrainTail, NumVoices> tails;
+        EventUtils::VoiceMask<NumVoices> fading;
+    };
+    void* m_voiceBank{nullptr};
+
+    // Voices and block buffers, carved out of one RT allocation
+    PluginUtils::RTArena m_arena;
+
+    // Trigger event resolved by the voice allocator
+    struct GrainEvent {
+        int sample;
+        int voice;
+        float offset;
+        float oscSlope;
+        float modSlope;
+        float pmIndexOsc;
+        float pmIndexMod;
+        float pmFilterRatioOsc;
+        float pmFilterRatioMod;
+        float warpOsc;
+        float warpMod;
+        double envSlope;
+    };
+
+    // Block buffers for voice-major rendering
+    GrainEvent* m_events{nullptr};
+    float* m_oscCyclePosBlock{nullptr};
+    float* m_modCyclePosBlock{nullptr};
+    float* m_skewBlock{nullptr};
+    float* m_indexBlock{nullptr};
+    float* m_outputBlock{nullptr};
+    float* m_overflowBlock{nullptr};
+
+    // Render a grain from start until end or its window completes, returns the stop sample
+    template<typename Interpolator>
+    int renderGrain(GrainData& grain, OscUtils::DualOscScaled& dualOsc,
+        const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& modTable,
+        int start, int end, float gain, float gainSlope);
+
+    // Render a stolen grain along its fade-out, returns true while it is still fading
+    template<typename Interpolator>
+    bool renderTail(GrainTail& tail,
+        const OscUtils::Wavetable& oscTable, const OscUtils::Wavetable& modTable,
+        int start, int end);
  
     // Output processing
     FilterUtils::OnePoleHz m_dcBlocker;
@@ -349,11 +510,16 @@ private:
         Skew,
         Index,
  
-        Oversample
+        Oversample,
+        Interp,
+        MaxVoices,
+        VoicePolicy,
+        VoiceStats
     };
  
     enum Outputs {
-        Out
+        Out,
+        Overflow
     };
 };
 
@@ -4,6 +4,7 @@
 #include <array>
 #include <cmath>  
 #include <algorithm>
+#include <limits>
 
 namespace EventUtils {
 
@@ -189,7 +190,7 @@ struct SchedulerCycle {
 
         // 5. Prepare output
         output.trigger = trigger;
-        output.phase = static_cast<float>(m_phase);
+        output.phase = sc_min(static_cast<float>(m_phase), MAX_PHASE);
         output.rate = static_cast<float>(m_slope * sampleRate);
         output.subSampleOffset = static_cast<float>(subSampleOffset);
 
@@ -198,6 +199,62 @@ struct SchedulerCycle {
 
         return output;
     }
+
+    // Below this slope every wrap is caught by the proportional wrap test and wraps are at least four samples apart
+    static constexpr double MAX_BLOCK_SLOPE = 0.25;
+
+    // Largest float below 1, a phase just below 1 in double would otherwise round up to 1 when cast
+    static constexpr float MAX_PHASE = 1.0f - std::numeric_limits<float>::epsilon() * 0.5f;
+
+    // Whole block at a constant rate without reset. The phase is accumulated and wrapped exactly as in process(),
+    // but below MAX_BLOCK_SLOPE every wrap is a trigger, so the proportional wrap test only runs once per block.
+    // Returns false without touching the state if the block needs the per-sample path
+    bool processBlock(float rate, float sampleRate, int nSamples,
+                      float* triggerOut, float* phaseOut, float* rateOut, float* offsetOut) {
+
+        const double newSlope = static_cast<double>(rate) / sampleRate;
+        if (nSamples < 2 || wrapDetect.m_lastWrap ||
+            !(m_slope > 0.0 && m_slope < MAX_BLOCK_SLOPE) ||
+            !(newSlope > 0.0 && newSlope < MAX_BLOCK_SLOPE)) {
+            return false;
+        }
+
+        std::fill_n(triggerOut, nSamples, 0.0f);
+        std::fill_n(offsetOut, nSamples, 0.0f);
+
+        double phase = m_phase;
+        double lastPhase = wrapDetect.m_lastPhase;
+        double prevPhase = lastPhase;
+        float rateValue = static_cast<float>(m_slope * sampleRate);
+
+        for (int i = 0; i < nSamples; ++i) {
+
+            // 1. Wrap phase between 0 and 1, latch slope and output trigger with subsample offset
+            if (phase >= 1.0) {
+                phase -= 1.0;
+                m_slope = newSlope;
+                rateValue = static_cast<float>(m_slope * sampleRate);
+                triggerOut[i] = 1.0f;
+                offsetOut[i] = static_cast<float>(phase / m_slope);
+            }
+
+            // 2. Output phase and latched rate
+            phaseOut[i] = sc_min(static_cast<float>(phase), MAX_PHASE);
+            rateOut[i] = rateValue;
+
+            // 3. Keep the last two phases for the wrap detector and increment phase
+            prevPhase = lastPhase;
+            lastPhase = phase;
+            phase += m_slope;
+        }
+
+        // Leave the wrap detector as the per-sample path would
+        m_phase = phase;
+        wrapDetect.m_lastPhase = prevPhase;
+        wrapDetect.process(lastPhase);
+
+        return true;
+    }
    
     void reset() {
         m_phase = 0.0;
@@ -227,8 +284,7 @@ struct SchedulerBurst {
     
         // Reset on new trigger
         if (trigger) {
-            reset();
-            m_hasTriggered = true;
+            start();
         }
 
         // Calculate slope from duration
@@ -265,6 +321,81 @@ struct SchedulerBurst {
     
         return output;
     }
+
+    // Below this slope steps are at least four samples apart, so only the first two samples of a burst need the per-sample path
+    static constexpr double MAX_BLOCK_SLOPE = 0.25;
+
+    // Whole block at a constant duration and cycle count without a new trigger. The scaled phase is accumulated
+    // as in process(), but below MAX_BLOCK_SLOPE every step is a trigger, so the step detector is not run per sample.
+    // Returns false without touching the state if the block needs the per-sample path
+    bool processBlock(float duration, int cycles, float sampleRate, int nSamples,
+                      float* triggerOut, float* phaseOut, float* rateOut, float* offsetOut) {
+
+        const double safeDuration = sc_max(static_cast<double>(duration), 1.0 / sampleRate);
+        const double slope = 1.0 / (safeDuration * sampleRate);
+
+        // Idle until the first trigger
+        if (!m_hasTriggered) {
+            m_slope = slope;
+            std::fill_n(triggerOut, nSamples, 0.0f);
+            std::fill_n(phaseOut, nSamples, 0.0f);
+            std::fill_n(rateOut, nSamples, 0.0f);
+            std::fill_n(offsetOut, nSamples, 0.0f);
+            return true;
+        }
+
+        // The previous slope has to be small as well, or the block could start on a step landing exactly on an integer
+        if (nSamples < 2 || stepDetect.m_lastStep || stepDetect.m_lastCeiling < 0.0 ||
+            !(m_slope < MAX_BLOCK_SLOPE) || !(slope < MAX_BLOCK_SLOPE)) {
+            return false;
+        }
+
+        m_slope = slope;
+        const double end = static_cast<double>(cycles);
+        const float rateValue = static_cast<float>(m_slope * sampleRate);
+
+        std::fill_n(triggerOut, nSamples, 0.0f);
+        std::fill_n(offsetOut, nSamples, 0.0f);
+
+        double phaseScaled = m_phaseScaled;
+        double ceiling = stepDetect.m_lastCeiling;
+        bool step = false;
+
+        for (int k = 0; k < nSamples; ++k) {
+
+            // 1. Clip scaled phase between 0 and cycles
+            phaseScaled = sc_clip(phaseScaled, 0.0, end);
+
+            // 2. Trigger where the scaled phase passes the next integer
+            const double currentCeiling = sc_ceil(phaseScaled);
+            step = currentCeiling > ceiling;
+            ceiling = currentCeiling;
+
+            // 3. Output phase, latched rate and subsample offset
+            const double phase = sc_frac(phaseScaled);
+            if (step) {
+                triggerOut[k] = 1.0f;
+                offsetOut[k] = static_cast<float>(phase / m_slope);
+            }
+            phaseOut[k] = static_cast<float>(phase);
+            rateOut[k] = rateValue;
+
+            // 4. Increment phase
+            phaseScaled += m_slope;
+        }
+
+        // Leave the step detector as the per-sample path would
+        stepDetect.m_lastCeiling = ceiling;
+        stepDetect.m_lastStep = step;
+        m_phaseScaled = phaseScaled;
+
+        return true;
+    }
+
+    void start() {
+        reset();
+        m_hasTriggered = true;
+    }
    
     void reset() {
         m_phaseScaled = 0.0;
@@ -274,69 +405,355 @@ struct SchedulerBurst {
     }
 };
 
+// ===== SCHEDULER LIST =====
+
+// Event list in an interleaved buffer, one frame per event:
+// onset in seconds (ascending), optional duration in seconds, optional parameters
+struct EventList {
+    const float* data{nullptr};
+    int numEvents{0};
+    int numChannels{1};
+    
+    double onset(int event) const {
+        return data[event * numChannels];
+    }
+    
+    // Duration from the second channel if positive, otherwise the time to the next onset
+    double duration(int event, double loopLength) const {
+        if (numChannels > 1) {
+            const double duration = data[event * numChannels + 1];
+            if (duration > 0.0) {
+                return duration;
+            }
+        }
+        if (event + 1 < numEvents && (loopLength <= 0.0 || onset(event + 1) < loopLength)) {
+            return onset(event + 1) - onset(event);
+        }
+        if (loopLength > 0.0) {
+            return loopLength - onset(event) + onset(0);
+        }
+        return event > 0 ? onset(event) - onset(event - 1) : 0.0;
+    }
+    
+    float param(int event, int index) const {
+        const int channel = index + 2;
+        return channel < numChannels ? data[event * numChannels + channel] : 0.0f;
+    }
+    
+    // First event with an onset at or after time
+    int find(double time) const {
+        int low = 0;
+        int high = numEvents;
+        while (low < high) {
+            const int mid = (low + high) / 2;
+            if (onset(mid) < time) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+};
+
+struct SchedulerList {
+    static constexpr int MAX_PARAMS = 16;
+    
+    double m_time{0.0};             // score position in seconds
+    double m_eventOnset{0.0};       // onset of the latched event
+    double m_eventDuration{0.0};    // duration of the latched event
+    int m_cursor{0};                // next event to fire
+    bool m_hasTriggered{false};
+    std::array<float, MAX_PARAMS> m_params{};
+    
+    int numParams{0};
+    
+    // Samples [start, end) at a constant speed and loop length. The samples between two events are filled
+    // as one span, so the cost grows with the number of events instead of testing every sample
+    void process(const EventList& events, float speed, float loopLength, float sampleRate, int start, int end,
+                 float* triggerOut, float* rateOut, float* offsetOut, float* phaseOut, float* const* paramOuts) {
+        
+        const double step = static_cast<double>(speed) / sampleRate;
+        const bool looping = loopLength > 0.0f;
+        const double loopEnd = looping ? static_cast<double>(loopLength) : std::numeric_limits<double>::infinity();
+        
+        std::fill(triggerOut + start, triggerOut + end, 0.0f);
+        std::fill(offsetOut + start, offsetOut + end, 0.0f);
+        
+        int i = start;
+        while (i < end) {
+            
+            // 1. Next boundary: onset of the next event or end of the loop
+            const bool hasEvent = m_cursor < events.numEvents && events.onset(m_cursor) < loopEnd;
+            const double nextOnset = hasEvent ? events.onset(m_cursor) : std::numeric_limits<double>::infinity();
+            const double boundary = sc_min(nextOnset, loopEnd);
+            
+            // 2. First sample at or after the boundary, or the end of the range if it lies beyond
+            int next = end;
+            if (boundary <= m_time) {
+                next = i;
+            } else if (step > 0.0) {
+                const double distance = (boundary - m_time) / step;
+                if (distance < static_cast<double>(end - i)) {
+                    next = i + static_cast<int>(std::ceil(distance));
+                }
+            }
+            
+            // 3. Fill the span up to the boundary from the latched event
+            fillSpan(i, next, step, sampleRate, rateOut, phaseOut, paramOuts);
+            m_time += (next - i) * step;
+            i = next;
+            if (i >= end) {
+                break;
+            }
+            
+            // 4. Wrap at the end of the loop, events at its start fire on the same sample
+            if (boundary >= loopEnd) {
+                m_time = std::fmod(sc_max(m_time - loopEnd, 0.0), loopEnd);
+                m_eventOnset -= loopEnd;
+                m_cursor = 0;
+                continue;
+            }
+            
+            // 5. Latch the event, the time passed since its onset is the subsample offset
+            m_eventOnset = nextOnset;
+            m_eventDuration = events.duration(m_cursor, looping ? loopEnd : 0.0);
+            for (int p = 0; p < numParams; ++p) {
+                m_params[p] = events.param(m_cursor, p);
+            }
+            m_hasTriggered = true;
+            ++m_cursor;
+            
+            triggerOut[i] = 1.0f;
+            offsetOut[i] = step > 0.0 ? static_cast<float>(sc_max(m_time - nextOnset, 0.0) / step) : 0.0f;
+        }
+    }
+    
+    // Move the cursor to the current score position, e.g. after the event list changed
+    void seek(const EventList& events) {
+        m_cursor = events.find(m_time);
+    }
+    
+    void reset() {
+        m_time = 0.0;
+        m_eventOnset = 0.0;
+        m_eventDuration = 0.0;
+        m_cursor = 0;
+        m_hasTriggered = false;
+        m_params.fill(0.0f);
+    }
+    
+private:
+    void fillSpan(int start, int end, double step, float sampleRate,
+                  float* rateOut, float* phaseOut, float* const* paramOuts) const {
+        
+        // Phase runs from 0 to 1 over the duration of the latched event and is 0 before and after
+        const bool active = m_hasTriggered && m_eventDuration > 0.0;
+        const double phaseStart = active ? (m_time - m_eventOnset) / m_eventDuration : 1.0;
+        const double phaseSlope = active ? step / m_eventDuration : 0.0;
+        const float rate = static_cast<float>(phaseSlope * sampleRate);
+        
+        for (int i = start; i < end; ++i) {
+            const double phase = phaseStart + (i - start) * phaseSlope;
+            phaseOut[i] = phase < 1.0 ? static_cast<float>(sc_max(phase, 0.0)) : 0.0f;
+        }
+        std::fill(rateOut + start, rateOut + end, rate);
+        for (int p = 0; p < numParams; ++p) {
+            std::fill(paramOuts[p] + start, paramOuts[p] + end, m_params[p]);
+        }
+    }
+};
+
 // ===== VOICE ALLOCATOR =====
 
+// Voice counts with allocator instantiations (powers of two from 4 to 128)
+inline constexpr int MIN_VOICES = 4;
+inline constexpr int MAX_VOICES = 128;
+
+// Round a requested voice count up to the next instantiated size
+inline int resolveVoiceCount(float value) {
+    const int requested = sc_clip(static_cast<int>(value), MIN_VOICES, MAX_VOICES);
+    return NEXTPOWEROFTWO(requested);
+}
+
+// Fixed-size voice bitmask, iterates set bits only
+template<int NumChannels>
+struct VoiceMask {
+    static constexpr int NUM_WORDS = (NumChannels + 63) / 64;
+    std::array<uint64_t, NUM_WORDS> words{};
+
+    void set(int ch) { words[ch >> 6] |= uint64_t(1) << (ch & 63); }
+    void clear(int ch) { words[ch >> 6] &= ~(uint64_t(1) << (ch & 63)); }
+    bool test(int ch) const { return (words[ch >> 6] >> (ch & 63)) & 1; }
+    void reset() { words.fill(0); }
+
+    // Lowest clear bit below limit, or -1 if all those channels are set
+    int firstClear(int limit = NumChannels) const {
+        for (int w = 0; w < NUM_WORDS; ++w) {
+            const uint64_t freeBits = ~words[w];
+            if (freeBits) {
+                const int ch = (w << 6) + Utils::countTrailingZeros(freeBits);
+                return ch < limit ? ch : -1;
+            }
+        }
+        return -1;
+    }
+
+    // Iterator over set bits, the current bit may be cleared while iterating
+    struct Iterator {
+        const uint64_t* words;
+        int wordIndex;
+        uint64_t bits;
+
+        int operator*() const { return (wordIndex << 6) + Utils::countTrailingZeros(bits); }
+        bool operator!=(const Iterator& other) const { return wordIndex != other.wordIndex || bits != other.bits; }
+
+        Iterator& operator++() {
+            bits &= bits - 1;
+            skipEmpty();
+            return *this;
+        }
+
+        void skipEmpty() {
+            while (bits == 0 && ++wordIndex < NUM_WORDS) {
+                bits = words[wordIndex];
+            }
+            if (bits == 0) {
+                wordIndex = NUM_WORDS;
+            }
+        }
+    };
+
+    Iterator begin() const {
+        Iterator it{words.data(), 0, words[0]};
+        it.skipEmpty();
+        return it;
+    }
+
+    Iterator end() const { return {words.data(), NUM_WORDS, 0}; }
+};
+
+// What happens to a trigger when every voice is busy
+enum class VoicePolicy {
+    DropNewest = 0,     // Discard the trigger
+    StealOldest,        // Restart the longest running voice
+    StealMostComplete   // Restart the voice closest to the end of its window
+};
+
+inline VoicePolicy resolveVoicePolicy(float value) {
+    return static_cast<VoicePolicy>(sc_clip(static_cast<int>(value), 0, 2));
+}
+
+// Fade-out time of stolen grains in the grain engines
+inline constexpr float STEAL_FADE_TIME = 0.002f;
+
+// Advance an event cursor to the next event of a voice, returns its sample or end if none is left
+template<typename Event>
+inline int nextVoiceEvent(const Event* events, int numEvents, int voice, int& cursor, int end) {
+    while (cursor < numEvents && events[cursor].voice != voice) {
+        ++cursor;
+    }
+    return cursor < numEvents ? events[cursor].sample : end;
+}
+
 template<int NumChannels>
 struct VoiceAllocator {
     // Internal processing state
     std::array<double, NumChannels> localPhases{};      
     std::array<double, NumChannels> localSlopes{};      
-    std::array<bool, NumChannels> isActive{};           
+    std::array<uint32_t, NumChannels> startCounts{};
+    VoiceMask<NumChannels> active;
+    uint32_t triggerCount{0};
+    
+    // Configuration
+    VoicePolicy policy{VoicePolicy::DropNewest};
+    int numChannels{NumChannels};
     
-    // Output interface
+    // Output interface (phases of idle channels stay at zero)
     std::array<float, NumChannels> phases{};            
-    std::array<bool, NumChannels> triggers{};           
+    int triggered{-1};
+    bool stolen{false};
+    uint32_t overflowCount{0};  // Running count of dropped or stolen triggers
     
     VoiceAllocator() = default;
     
-    void process(bool trigger, float rate, float subSampleOffset, float sampleRate) {
-        // Clear output triggers
-        std::fill(triggers.begin(), triggers.end(), false);
-        
-        // 1. Free completed voices
-        for (int ch = 0; ch < NumChannels; ++ch) {
-            if (isActive[ch] && localPhases[ch] >= 1.0) {
-                isActive[ch] = false;
-                localPhases[ch] = 0.0;
+    bool isActive(int ch) const { return active.test(ch); }
+    
+    // Choose a busy voice to restart according to the policy
+    int selectVictim() const {
+        int victim = -1;
+        if (policy == VoicePolicy::StealOldest) {
+            uint32_t maxAge = 0;
+            for (int ch : active) {
+                const uint32_t age = triggerCount - startCounts[ch];
+                if (victim < 0 || age > maxAge) {
+                    maxAge = age;
+                    victim = ch;
+                }
             }
-        }
-        
-        // 2. Allocate new voice if trigger
-        if (trigger) {
-            for (int ch = 0; ch < NumChannels; ++ch) {
-                if (!isActive[ch]) {
-                    localSlopes[ch] = static_cast<double>(rate) / sampleRate;
-                    localPhases[ch] = localSlopes[ch] * subSampleOffset;
-                    isActive[ch] = true;
-                    triggers[ch] = true;
-                    break;
+        } else {
+            for (int ch : active) {
+                if (victim < 0 || localPhases[ch] > localPhases[victim]) {
+                    victim = ch;
                 }
             }
         }
+        return victim;
+    }
+    
+    // Returns the channel allocated for the trigger, or -1 if none
+    int process(bool trigger, float rate, float subSampleOffset, float sampleRate) {
+        triggered = -1;
+        stolen = false;
         
-        // 3. Output current phase
-        for (int ch = 0; ch < NumChannels; ++ch) {
-            if (isActive[ch] && localPhases[ch] < 1.0) {
-                phases[ch] = static_cast<float>(localPhases[ch]);
-            } else {
+        // 1. Free completed voices, output and increment the others
+        for (int ch : active) {
+            if (localPhases[ch] >= 1.0) {
+                active.clear(ch);
+                localPhases[ch] = 0.0;
                 phases[ch] = 0.0f;
+            } else {
+                phases[ch] = static_cast<float>(localPhases[ch]);
+                localPhases[ch] += localSlopes[ch];
             }
         }
         
-        // 4. Increment all active voices
-        for (int ch = 0; ch < NumChannels; ++ch) {
-            if (isActive[ch]) {
+        // 2. Allocate lowest free voice if trigger, otherwise apply the policy
+        if (trigger) {
+            int ch = active.firstClear(numChannels);
+            if (ch < 0) {
+                ++overflowCount;
+                if (policy != VoicePolicy::DropNewest) {
+                    ch = selectVictim();
+                    stolen = true;
+                }
+            }
+            if (ch >= 0) {
+                localSlopes[ch] = static_cast<double>(rate) / sampleRate;
+                localPhases[ch] = localSlopes[ch] * subSampleOffset;
+                startCounts[ch] = triggerCount++;
+                active.set(ch);
+                triggered = ch;
+                
+                // Output current phase and increment
+                phases[ch] = localPhases[ch] < 1.0 ? static_cast<float>(localPhases[ch]) : 0.0f;
                 localPhases[ch] += localSlopes[ch];
             }
         }
+        
+        return triggered;
     }
     
     void reset() {
         std::fill(localPhases.begin(), localPhases.end(), 0.0);
         std::fill(localSlopes.begin(), localSlopes.end(), 0.0);
-        std::fill(isActive.begin(), isActive.end(), false);
         std::fill(phases.begin(), phases.end(), 0.0f);
-        std::fill(triggers.begin(), triggers.end(), false);
+        startCounts.fill(0);
+        active.reset();
+        triggerCount = 0;
+        triggered = -1;
+        stolen = false;
+        overflowCount = 0;
     }
 };
 
@@ -570,4 +987,128 @@ struct RampDividerOffset {
     }
 };
 
+// ===== RAMP DIVIDER BANK =====
+
+// Several dividers of one ramp: slope and wrap detection are derived once per sample and shared,
+// the divider states are kept as arrays so each update runs as one loop across the ratios.
+// Every divider follows RampDividerSimple, RampDividerGrid or RampDividerOffset exactly.
+template<int MaxDividers>
+struct RampDividerBank {
+    RampToSlope m_slopeCalc;
+    RampToTrig m_wrapDetect;
+    
+    int numDividers{MaxDividers};
+    
+    // Divider states, one entry per ratio
+    std::array<double, MaxDividers> m_phase{};
+    std::array<double, MaxDividers> m_lastRatio{};      // Grid: ratio of the previous sample
+    std::array<bool, MaxDividers> m_syncLatched{};      // Grid: sync requested, released on wrap
+    std::array<double, MaxDividers> m_target{};         // Offset: phase on the new grid
+    std::array<double, MaxDividers> m_latchedSlope{};   // Offset: slope held until the next switch
+    std::array<double, MaxDividers> m_lastValue{};      // Offset: ratio change detection
+    std::array<bool, MaxDividers> m_lastSwitch{};       // Offset: previous sample switched
+    
+    RampDividerBank() {
+        reset();
+    }
+    
+    void processSimple(double phase, const float* ratios, bool resetTrigger, float* output) {
+        
+        // Shared slope of the input ramp
+        const double slope = m_slopeCalc.process(phase);
+        
+        for (int k = 0; k < numDividers; ++k) {
+            const double scaledSlope = slope / sc_max(std::abs(ratios[k]), Utils::SAFE_DENOM_EPSILON);
+            m_phase[k] = resetTrigger ? 0.0 : m_phase[k] + scaledSlope;
+            output[k] = static_cast<float>(sc_frac(m_phase[k]));
+        }
+    }
+    
+    void processGrid(double phase, const float* ratios, bool resetTrigger, float* output) {
+        
+        // Shared slope and wrap of the input ramp
+        const double slope = m_slopeCalc.process(phase);
+        const bool wrapTrigger = m_wrapDetect.process(phase);
+        
+        for (int k = 0; k < numDividers; ++k) {
+            const float safeRatio = sc_max(std::abs(ratios[k]), Utils::SAFE_DENOM_EPSILON);
+            const double scaledSlope = slope / safeRatio;
+            
+            // Latch sync request on proportional ratio change, release on wrap
+            const double delta = safeRatio - m_lastRatio[k];
+            const double sum = safeRatio + m_lastRatio[k];
+            const bool ratioChanged = (sum != 0.0) && (std::abs(delta / sum) > RampDividerGrid::SYNC_THRESHOLD);
+            const bool latched = m_syncLatched[k] || ratioChanged;
+            const bool syncTrigger = wrapTrigger && latched;
+            m_syncLatched[k] = latched && !wrapTrigger;
+            
+            // Sync to grid on request or reset, otherwise free-running increment
+            const double nextPhase = m_phase[k] + scaledSlope;
+            if (syncTrigger || resetTrigger) {
+                const double scaledPhase = phase / safeRatio;
+                const double offset = nextPhase - scaledPhase;
+                m_phase[k] = std::trunc(offset * safeRatio) / safeRatio + scaledPhase;
+            } else {
+                m_phase[k] = nextPhase;
+            }
+            
+            output[k] = static_cast<float>(sc_frac(m_phase[k]));
+            m_lastRatio[k] = safeRatio;
+        }
+    }
+    
+    void processOffset(double phase, const float* ratios, bool resetTrigger, float* output) {
+        
+        // Shared slope of the input ramp
+        const double slope = m_slopeCalc.process(phase);
+        
+        for (int k = 0; k < numDividers; ++k) {
+            const float safeRatio = sc_max(std::abs(ratios[k]), Utils::SAFE_DENOM_EPSILON);
+            const double scaledSlope = slope / safeRatio;
+            
+            // Latch slope when the previous sample switched
+            if (m_lastSwitch[k]) {
+                m_latchedSlope[k] = scaledSlope;
+            }
+            
+            // Detect any change in ratio
+            const bool ratioChanged = static_cast<double>(safeRatio) != m_lastValue[k];
+            m_lastValue[k] = safeRatio;
+            
+            // Update target: sync to grid on ratio change or reset, otherwise free-running increment
+            const double nextPhase = m_phase[k] + m_latchedSlope[k];
+            if (ratioChanged || resetTrigger) {
+                const double scaledPhase = phase / safeRatio;
+                const double offset = nextPhase - scaledPhase;
+                m_target[k] = std::trunc(offset * safeRatio) / safeRatio + scaledPhase;
+            } else {
+                m_target[k] += scaledSlope;
+            }
+            m_target[k] = sc_frac(m_target[k]);
+            
+            // Switch to target once the phases are close and the slopes differ
+            const double slopeDiff = std::abs(m_latchedSlope[k] - scaledSlope);
+            const double phaseDiff = sc_wrap(nextPhase - m_target[k], -0.5, 0.5);
+            const bool canSwitch = (std::abs(phaseDiff) < (slopeDiff * 2.0)) && (slopeDiff != 0.0);
+            const bool switchTrigger = canSwitch || resetTrigger;
+            
+            m_phase[k] = sc_frac(switchTrigger ? m_target[k] : nextPhase);
+            output[k] = static_cast<float>(m_phase[k]);
+            m_lastSwitch[k] = switchTrigger;
+        }
+    }
+    
+    void reset() {
+        m_slopeCalc.reset();
+        m_wrapDetect.reset();
+        m_phase.fill(0.0);
+        m_lastRatio.fill(1.0);
+        m_syncLatched.fill(false);
+        m_target.fill(0.0);
+        m_latchedSlope.fill(0.0);
+        m_lastValue.fill(0.0);
+        m_lastSwitch.fill(true);
+    }
+};
+
 } // namespace EventUtils
\ No newline at end of file
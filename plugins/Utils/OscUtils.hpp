@@ -2,18 +2,18 @@
 #include "SC_PlugIn.hpp"
 #include "Utils.hpp"
 #include "FilterUtils.hpp"
+#include "PluginUtils.hpp"
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 
 namespace OscUtils {
     
 // ===== SINC INTERPOLATION UTILITIES =====
 
-struct SincTable {
-    static constexpr int POINTS = 8;
-    static constexpr int HALF_POINTS = POINTS / 2;
-    static constexpr int SIZE = 8192;
-    static constexpr int SPACING = SIZE / POINTS;
+struct SincKernel {
+    static constexpr int SPACING = 1024;
     static constexpr double ALPHA = 3.0;
 
     // Modified Bessel function I₀
@@ -56,62 +56,149 @@ struct SincTable {
         double arg = x * ripples * Utils::PI;
         return std::sin(arg) / arg;
     }
-        
-    // Windowed sinc interpolation table
-    static inline const std::array<float, SIZE> TABLE = []() {
-        std::array<float, SIZE> result{};
-
-        for (int i = 0; i < SIZE; ++i) {
-            double x = (static_cast<double>(i) / (SIZE - 1)) * 2.0 - 1.0;
-            
-            double sinc = sincPi(x, HALF_POINTS);
-            double window = kaiser(x, ALPHA);
-            
-            result[i] = static_cast<float>(sinc * window);
+};
+
+// One table per kernel width, instantiated for 8, 16 and 32 points
+template<int Points>
+struct SincTable : SincKernel {
+    static constexpr int POINTS = Points;
+    static constexpr int HALF_POINTS = POINTS / 2;
+    static constexpr int SIZE = POINTS * SPACING;
+
+    // Windowed sinc kernel, zero outside of [-1, 1]
+    static inline double kernel(double x) {
+        if (sc_abs(x) > 1.0) {
+            return 0.0;
         }
-        
+        return sincPi(x, HALF_POINTS) * kaiser(x, ALPHA);
+    }
+
+    // Polyphase layout [phase][POINTS], one contiguous row of tap coefficients per fractional position
+    // An extra row at PHASES allows blending between adjacent rows without wrapping
+    static constexpr int PHASES = SPACING;
+
+    struct alignas(64) PolyphaseTable {
+        float rows[PHASES + 1][POINTS];
+    };
+
+    static inline const PolyphaseTable POLYPHASE = []() {
+        PolyphaseTable result{};
+
+        for (int phase = 0; phase <= PHASES; ++phase) {
+            for (int i = 0; i < POINTS; ++i) {
+                double pos = static_cast<double>(i * SPACING - phase);
+                double x = (pos / (SIZE - 1)) * 2.0 - 1.0;
+                result.rows[phase][i] = static_cast<float>(kernel(x));
+            }
+        }
+
         return result;
     }();
 };
 
 // ===== HIGH-PERFORMANCE SINC INTERPOLATION =====
 
+template<int Points>
 inline float sincInterp(float scaledPhase, const float* buffer, int startPos, int endPos, int sampleSpacing) {
+    using Table = SincTable<Points>;
 
-    // const pointer to sincTable data
-    const float* const sincData = SincTable::TABLE.data();
-
+    // Floor keeps the fraction positive for phases below zero
     const float sampleIndex = scaledPhase / static_cast<float>(sampleSpacing);
-    const int intPart = static_cast<int>(sampleIndex);
+    const int intPart = static_cast<int>(std::floor(sampleIndex));
     const float fracPart = sampleIndex - static_cast<float>(intPart);
 
-    // Pre-calculate offsets
-    const float sincOffset = fracPart * SincTable::SPACING;
-    const int waveOffset = intPart * sampleSpacing;
+    // Select adjacent coefficient rows for the fractional position
+    const float rowPos = fracPart * Table::PHASES;
+    const int rowIndex = sc_min(static_cast<int>(rowPos), Table::PHASES - 1);
+    const float rowFrac = rowPos - static_cast<float>(rowIndex);
+    const float* const row1 = Table::POLYPHASE.rows[rowIndex];
+    const float* const row2 = Table::POLYPHASE.rows[rowIndex + 1];
+
+    // Pre-calculate offsets and masks
+    const int cycleSize = endPos - startPos;
+    const int waveMask = cycleSize - 1;
+    const int firstIndex = (intPart - Table::HALF_POINTS) * sampleSpacing;
+
+    // Read contiguous taps in place, otherwise gather them with wrapping
+    const float* taps;
+    alignas(32) float gathered[Table::POINTS];
+    if (sampleSpacing == 1 && firstIndex >= 0 && firstIndex + Table::POINTS <= cycleSize) {
+        taps = buffer + startPos + firstIndex;
+    } else {
+        for (int i = 0; i < Table::POINTS; ++i) {
+            gathered[i] = Utils::peekNoInterp(buffer, firstIndex + i * sampleSpacing, startPos, waveMask);
+        }
+        taps = gathered;
+    }
+
+    // Dot products with both rows, blended by the remaining fraction
+    const float sig1 = Utils::dotProduct<Table::POINTS>(taps, row1);
+    const float sig2 = Utils::dotProduct<Table::POINTS>(taps, row2);
+    return lininterp(rowFrac, sig1, sig2);
+}
 
-    // Pre-calculate masks
-    const int sincMask = SincTable::SIZE - 1;
-    const int waveMask = (endPos - startPos) - 1;
+// ===== INTERPOLATION QUALITY =====
 
-    float result = 0.0f;
-    for (int i = 0; i < SincTable::POINTS; ++i) {
+// Interpolators share the sinc interface, sampleSpacing > 1 reads a strided (decimated) view of the cycle
+struct LinearInterp {
+    static float process(float scaledPhase, const float* buffer, int startPos, int endPos, int sampleSpacing) {
+        const int waveMask = (endPos - startPos) - 1;
+        if (sampleSpacing == 1) {
+            return Utils::peekLinearInterp(buffer + startPos, scaledPhase, waveMask);
+        }
 
-        // === WAVEFORM BUFFER ACCESS (no interpolation) ===
-        const int waveIndex = (i - SincTable::HALF_POINTS) * sampleSpacing + waveOffset;
-        const float waveSample = Utils::peekNoInterp(buffer, waveIndex, startPos, waveMask);
-        
-        // === SINC TABLE ACCESS (linear interpolation) ===
-        const float sincPos = static_cast<float>(i * SincTable::SPACING) - sincOffset;
-        const float sincSample = Utils::peekLinearInterp(sincData, sincPos, sincMask);
-        
-        result += waveSample * sincSample;
+        const float sampleIndex = scaledPhase / static_cast<float>(sampleSpacing);
+        const int intPart = static_cast<int>(sampleIndex);
+        const float fracPart = sampleIndex - static_cast<float>(intPart);
+
+        const float a = Utils::peekNoInterp(buffer, intPart * sampleSpacing, startPos, waveMask);
+        const float b = Utils::peekNoInterp(buffer, (intPart + 1) * sampleSpacing, startPos, waveMask);
+        return lininterp(fracPart, a, b);
     }
-    
-    return result;
+};
+
+struct CubicInterp {
+    static float process(float scaledPhase, const float* buffer, int startPos, int endPos, int sampleSpacing) {
+        const int waveMask = (endPos - startPos) - 1;
+        if (sampleSpacing == 1) {
+            return Utils::peekCubicInterp(buffer + startPos, scaledPhase, waveMask);
+        }
+
+        const float sampleIndex = scaledPhase / static_cast<float>(sampleSpacing);
+        const int intPart = static_cast<int>(sampleIndex);
+        const float fracPart = sampleIndex - static_cast<float>(intPart);
+
+        const float a = Utils::peekNoInterp(buffer, (intPart - 1) * sampleSpacing, startPos, waveMask);
+        const float b = Utils::peekNoInterp(buffer, intPart * sampleSpacing, startPos, waveMask);
+        const float c = Utils::peekNoInterp(buffer, (intPart + 1) * sampleSpacing, startPos, waveMask);
+        const float d = Utils::peekNoInterp(buffer, (intPart + 2) * sampleSpacing, startPos, waveMask);
+        return cubicinterp(fracPart, a, b, c, d);
+    }
+};
+
+template<int Points>
+struct SincInterp {
+    static float process(float scaledPhase, const float* buffer, int startPos, int endPos, int sampleSpacing) {
+        return sincInterp<Points>(scaledPhase, buffer, startPos, endPos, sampleSpacing);
+    }
+};
+
+// Values of the interp input: 0 = linear, 1 = cubic, 2 = 8-point sinc, 3 = 16-point sinc, 4 = 32-point sinc
+enum InterpQuality {
+    InterpLinear,
+    InterpCubic,
+    InterpSinc8,
+    InterpSinc16,
+    InterpSinc32
+};
+
+inline int resolveInterpQuality(float value) {
+    return sc_clip(static_cast<int>(value), static_cast<int>(InterpLinear), static_cast<int>(InterpSinc32));
 }
 
 // ===== MIPMAP UTILITIES =====
 
+template<typename Interpolator>
 inline float mipmapInterp(float phase, const float* buffer, int startPos, int endPos, 
                                int spacing1, int spacing2, float crossfade) {
     
@@ -120,45 +207,416 @@ inline float mipmapInterp(float phase, const float* buffer, int startPos, int en
     const float scaledPhase = phase * rangeSize;
     
     // Check for sinc kernel bandwidth limit (1024)
-    if (spacing1 >= SincTable::SPACING) {
+    if (spacing1 >= SincKernel::SPACING) {
+        // no crossfade to next mipmap layer
+        return Interpolator::process(scaledPhase, buffer, startPos, endPos, SincKernel::SPACING);
+    } else {
+        // Crossfade between adjacent mipmap layers
+        const float sig1 = Interpolator::process(scaledPhase, buffer, startPos, endPos, spacing1);
+        const float sig2 = Interpolator::process(scaledPhase, buffer, startPos, endPos, spacing2);
+        return lininterp(crossfade, sig1, sig2);
+    }
+}
+
+// ===== MIPMAP PYRAMID =====
+
+struct MipmapPyramid {
+    static constexpr int MAX_LEVELS = 11;
+    static constexpr int MIN_LEVEL_SAMPLES = 2;
+    static constexpr int HALFBAND_RADIUS = 32;
+    static constexpr int HALFBAND_TAPS = HALFBAND_RADIUS / 2;
+
+    // Kaiser-windowed halfband kernel, odd taps only (even taps are zero except the center tap)
+    static inline const std::array<float, HALFBAND_TAPS> HALFBAND = []() {
+        std::array<float, HALFBAND_TAPS> result{};
+
+        double sum = 0.0;
+        for (int j = 0; j < HALFBAND_TAPS; ++j) {
+            double x = static_cast<double>(2 * j + 1) / HALFBAND_RADIUS;
+
+            double sinc = SincKernel::sincPi(x, HALFBAND_RADIUS / 2);
+            double window = SincKernel::kaiser(x, SincKernel::ALPHA);
+
+            result[j] = static_cast<float>(0.5 * sinc * window);
+            sum += 2.0 * result[j];
+        }
+
+        // Normalize odd taps so the kernel has unity gain at DC
+        for (int j = 0; j < HALFBAND_TAPS; ++j) {
+            result[j] = static_cast<float>(result[j] * 0.5 / sum);
+        }
+
+        return result;
+    }();
+
+    // Level 0 is the source buffer, each further level is band-limited and decimated by 2
+    std::array<const float*, MAX_LEVELS> levels{};
+    int numLevels{0};
+    int numCycles{0};
+    int cycleSamples{0};
+
+    // Number of levels for a cycle size, 0 if the cycle size is not a power-of-2
+    static int countLevels(int cycleSamples) {
+        if (cycleSamples <= 0 || (cycleSamples & (cycleSamples - 1)) != 0) {
+            return 0;
+        }
+
+        int count = 1;
+        while (count < MAX_LEVELS && (cycleSamples >> count) >= MIN_LEVEL_SAMPLES) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Number of samples needed to store all levels above level 0
+    static int storageSize(int numCycles, int cycleSamples) {
+        const int count = countLevels(cycleSamples);
+
+        int size = 0;
+        for (int level = 1; level < count; ++level) {
+            size += numCycles * (cycleSamples >> level);
+        }
+        return size;
+    }
+
+    // Decimate one periodic cycle by 2 with the halfband kernel
+    static void decimate(const float* input, int inputSamples, float* output) {
+        const int mask = inputSamples - 1;
+        const int outputSamples = inputSamples >> 1;
+
+        for (int n = 0; n < outputSamples; ++n) {
+            const int center = 2 * n;
+
+            float sum = 0.5f * input[center];
+            for (int j = 0; j < HALFBAND_TAPS; ++j) {
+                const int offset = 2 * j + 1;
+                sum += HALFBAND[j] * (input[(center - offset) & mask] + input[(center + offset) & mask]);
+            }
+            output[n] = sum;
+        }
+    }
+
+    // Build all levels from the source buffer, storage has to hold storageSize() samples
+    bool build(const float* source, int numCyclesIn, int cycleSamplesIn, float* storage) {
+        numLevels = countLevels(cycleSamplesIn);
+        numCycles = numCyclesIn;
+        cycleSamples = cycleSamplesIn;
+
+        if (numLevels == 0) {
+            return false;
+        }
+
+        levels[0] = source;
+
+        float* levelData = storage;
+        for (int level = 1; level < numLevels; ++level) {
+            const int prevSamples = cycleSamples >> (level - 1);
+            const int levelSamples = cycleSamples >> level;
+
+            for (int cycle = 0; cycle < numCycles; ++cycle) {
+                decimate(levels[level - 1] + cycle * prevSamples, prevSamples, levelData + cycle * levelSamples);
+            }
+
+            levels[level] = levelData;
+            levelData += numCycles * levelSamples;
+        }
+
+        return true;
+    }
+};
+
+// ===== PREPARED WAVETABLE REGISTRY =====
+
+// Built on the NRT thread by the prepareWavetable plugin command, immutable once published
+struct PreparedWavetable {
+    const float* sourceData;
+    int sourceSize;
+    int numCycles;
+    MipmapPyramid pyramid;
+
+    // Single NRT allocation holding the struct, the pyramid levels and a copy of the source
+    static size_t allocSize(int numCycles, int cycleSamples) {
+        const int sourceSize = numCycles * cycleSamples;
+        return sizeof(PreparedWavetable) + 
+            (MipmapPyramid::storageSize(numCycles, cycleSamples) + sourceSize) * sizeof(float);
+    }
+
+    float* storage() {
+        return reinterpret_cast<float*>(this + 1);
+    }
+
+    // Contents of the source at prepare time, to detect buffers rewritten in place
+    float* snapshot() {
+        return storage() + MipmapPyramid::storageSize(numCycles, sourceSize / numCycles);
+    }
+
+    const float* snapshot() const {
+        return const_cast<PreparedWavetable*>(this)->snapshot();
+    }
+};
+
+// Slots are indexed by bufnum and only ever written on the RT thread (stage 3 of the commands)
+struct WavetableRegistry {
+    std::atomic<PreparedWavetable**> m_slots{nullptr};
+    int m_numSlots{0};
+    std::atomic<int> m_generation{0};
+
+    // Buffer array of the owning World, a new World at the address of a shut down one has its own
+    std::atomic<const SndBuf*> m_sndBufs{nullptr};
+
+    const PreparedWavetable* find(uint32 bufnum, const float* data, int size, int numCycles) const {
+        PreparedWavetable** slots = m_slots.load(std::memory_order_relaxed);
+        if (!slots || bufnum >= static_cast<uint32>(m_numSlots)) {
+            return nullptr;
+        }
+
+        // Only valid while the buffer and its cycle layout match the prepared state,
+        // the contents are verified by the MipmapCache of each unit
+        const PreparedWavetable* prepared = slots[bufnum];
+        if (!prepared || prepared->sourceData != data || prepared->sourceSize != size || prepared->numCycles != numCycles) {
+            return nullptr;
+        }
+
+        return prepared;
+    }
+
+    // NRT thread: free the slots and all prepared levels, once no unit can look them up any more
+    void clear() {
+        PreparedWavetable** slots = m_slots.exchange(nullptr);
+        if (slots) {
+            for (int bufnum = 0; bufnum < m_numSlots; ++bufnum) {
+                NRTFree(slots[bufnum]);
+            }
+            NRTFree(slots);
+        }
+        m_numSlots = 0;
+        m_generation++;
+    }
+};
+
+// One registry per World, as several servers can run in one process.
+// Registries are claimed by the plugin commands, units only look them up
+struct WavetableRegistries {
+    static constexpr int MAX_WORLDS = 16;
+    std::array<std::atomic<World*>, MAX_WORLDS> owners{};
+    std::array<WavetableRegistry, MAX_WORLDS> registries;
+
+    static WavetableRegistries& instance() {
+        static WavetableRegistries registries;
+        return registries;
+    }
+};
+
+inline WavetableRegistry* wavetableRegistry(World* world, bool claim = false) {
+    auto& all = WavetableRegistries::instance();
+
+    for (int i = 0; i < WavetableRegistries::MAX_WORLDS; ++i) {
+        World* owner = all.owners[i].load(std::memory_order_acquire);
+        if (!owner && claim) {
+            all.owners[i].compare_exchange_strong(owner, world, std::memory_order_acq_rel);
+            if (!owner) {
+                all.registries[i].m_sndBufs.store(world->mSndBufs, std::memory_order_release);
+                return &all.registries[i];
+            }
+        }
+        if (owner == world) {
+            WavetableRegistry& registry = all.registries[i];
+            if (registry.m_sndBufs.load(std::memory_order_acquire) == world->mSndBufs) {
+                return &registry;
+            }
+
+            // Left behind by a World shut down at the same address: units never look it up,
+            // the claiming command (NRT thread) frees its levels and takes it over
+            if (!claim) {
+                return nullptr;
+            }
+            registry.clear();
+            registry.m_sndBufs.store(world->mSndBufs, std::memory_order_release);
+            return &registry;
+        }
+        if (!owner) {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+// Free the registries of all Worlds, once none of them is running any more
+inline void releaseWavetableRegistries() {
+    auto& all = WavetableRegistries::instance();
+
+    for (int i = 0; i < WavetableRegistries::MAX_WORLDS; ++i) {
+        all.registries[i].clear();
+        all.registries[i].m_sndBufs.store(nullptr);
+        all.owners[i].store(nullptr);
+    }
+}
+
+// ===== MIPMAP PYRAMID CACHE =====
+
+struct MipmapCache {
+    // The source is compared against the prepared copy in chunks, so that all of it is checked within this many blocks
+    static constexpr int VERIFY_BLOCKS = 64;
+    static constexpr int MIN_VERIFY_SAMPLES = 256;
+
+    const PreparedWavetable* m_prepared{nullptr};
+
+    // Cache key
+    uint32 m_bufnum{0};
+    const float* m_data{nullptr};
+    int m_size{0};
+    int m_numCycles{0};
+    int m_generation{-1};
+
+    // Content verification
+    int m_verifyPos{0};
+
+    const MipmapPyramid* get(World* world, uint32 bufnum, const float* data, int size, int numCycles) {
+        const WavetableRegistry* registry = wavetableRegistry(world);
+        if (!registry) {
+            return nullptr;
+        }
+
+        // Look up again only if the buffer, its cycle layout or the registry changed
+        const int generation = registry->m_generation.load(std::memory_order_relaxed);
+        if (bufnum != m_bufnum || data != m_data || size != m_size || numCycles != m_numCycles ||
+            generation != m_generation) {
+            m_bufnum = bufnum;
+            m_data = data;
+            m_size = size;
+            m_numCycles = numCycles;
+            m_generation = generation;
+            m_prepared = registry->find(bufnum, data, size, numCycles);
+            m_verifyPos = 0;
+        }
+
+        if (!m_prepared) {
+            return nullptr;
+        }
+
+        // Drop the levels once the contents differ from the prepared ones, until the buffer is prepared again
+        const int chunk = sc_min(sc_max((size + VERIFY_BLOCKS - 1) / VERIFY_BLOCKS, MIN_VERIFY_SAMPLES), size);
+        const int count = sc_min(chunk, size - m_verifyPos);
+        if (std::memcmp(data + m_verifyPos, m_prepared->snapshot() + m_verifyPos, count * sizeof(float)) != 0) {
+            m_prepared = nullptr;
+            return nullptr;
+        }
+        m_verifyPos = (m_verifyPos + count) % size;
+
+        return &m_prepared->pyramid;
+    }
+};
+
+// ===== WAVETABLE BUFFER ACCESS =====
+
+struct Wavetable {
+    bool valid;
+    const float* data;
+    int size;
+    int cycleSamples;
+    int numCycles;
+    const MipmapPyramid* pyramid;
+};
+
+struct WavetableBufUnit {
+    PluginUtils::BufUnit m_bufUnit;
+    MipmapCache m_mipmapCache;
+
+    Wavetable GetTable(Unit* unit, float fbufnum, int numCycles, const char* unitName) {
+        auto table = m_bufUnit.GetTable(unit, fbufnum, unitName);
+        if (!table.valid) {
+            return {false, nullptr, 0, 0, 0, nullptr};
+        }
+
+        // Use prepared mipmap levels if available, otherwise fall back to strided sinc interpolation
+        const int cycleSamples = table.size / numCycles;
+        const uint32 bufnum = static_cast<uint32>(m_bufUnit.m_fbufnum);
+        const MipmapPyramid* pyramid = m_mipmapCache.get(unit->mWorld, bufnum, table.data, table.size, numCycles);
+
+        return {true, table.data, table.size, cycleSamples, numCycles, pyramid};
+    }
+};
+
+// ===== MIPMAP LEVEL SELECTION =====
+
+struct MipmapLevel {
+    int layer{0};
+    float crossfade{0.0f};
+};
+
+// Use ceil without oversampling, floor with oversampling
+inline MipmapLevel mipmapLevel(float slope, int cycleSamples, bool oversampled) {
+    const float samplesPerFrame = std::abs(slope) * static_cast<float>(cycleSamples);
+    const float octave = sc_max(0.0f, sc_log2(samplesPerFrame));
+    const int layer = oversampled ?
+        static_cast<int>(sc_floor(octave)) :
+        static_cast<int>(sc_ceil(octave));
+    return {layer, sc_frac(octave)};
+}
+
+// ===== PYRAMID MIPMAP UTILITIES =====
+
+template<typename Interpolator>
+inline float levelInterp(float phase, const MipmapPyramid& pyramid, int level, int cycleIndex) {
+
+    // Each level stores its cycles contiguously, read with unit sample spacing
+    const int levelSamples = pyramid.cycleSamples >> level;
+    const int startPos = cycleIndex * levelSamples;
+    const float scaledPhase = phase * static_cast<float>(levelSamples);
+
+    return Interpolator::process(scaledPhase, pyramid.levels[level], startPos, startPos + levelSamples, 1);
+}
+
+template<typename Interpolator>
+inline float mipmapInterp(float phase, const Wavetable& table, int cycleIndex, int layer, float crossfade) {
+
+    // Fall back to strided interpolation on the source buffer
+    if (!table.pyramid) {
+        const int startPos = cycleIndex * table.cycleSamples;
+        const int endPos = startPos + table.cycleSamples;
+        const int spacing1 = 1 << layer;
+        const int spacing2 = spacing1 << 1;
+        return mipmapInterp<Interpolator>(phase, table.data, startPos, endPos, spacing1, spacing2, crossfade);
+    }
+
+    // Check for highest pyramid level
+    const MipmapPyramid& pyramid = *table.pyramid;
+    const int topLevel = pyramid.numLevels - 1;
+    if (layer >= topLevel) {
         // no crossfade to next mipmap layer
-        return sincInterp(scaledPhase, buffer, startPos, endPos, SincTable::SPACING);
+        return levelInterp<Interpolator>(phase, pyramid, topLevel, cycleIndex);
     } else {
         // Crossfade between adjacent mipmap layers
-        const float sig1 = sincInterp(scaledPhase, buffer, startPos, endPos, spacing1);
-        const float sig2 = sincInterp(scaledPhase, buffer, startPos, endPos, spacing2);
+        const float sig1 = levelInterp<Interpolator>(phase, pyramid, layer, cycleIndex);
+        const float sig2 = levelInterp<Interpolator>(phase, pyramid, layer + 1, cycleIndex);
         return lininterp(crossfade, sig1, sig2);
     }
 }
 
 // ===== MULTI-CYCLE WAVETABLE UTILITIES =====
 
-inline float wavetableOsc(float phase, const float* buffer, int cycleSamples, int numCycles, float cyclePos, 
-                                  int spacing1, int spacing2, float crossfade) {
+template<typename Interpolator>
+inline float wavetableOsc(float phase, const Wavetable& table, float cyclePos, int layer, float crossfade) {
 
     // Scale cyclePos and calculate frac and int part
-    const float scaledPos = cyclePos * static_cast<float>(numCycles - 1);
+    const float scaledPos = cyclePos * static_cast<float>(table.numCycles - 1);
     const int intPart = static_cast<int>(scaledPos);
     const float fracPart = scaledPos - static_cast<float>(intPart);
     
     // intPart ∈ [0, numCycles-1], no wrapping needed already guaranteed < numCycles
     const int cycleIndex1 = intPart;
-    const int startPos1 = cycleIndex1 * cycleSamples;
-    const int endPos1 = startPos1 + cycleSamples;
     
     // Early exit for fracPart == 0 (no crossfade needed)
     if (fracPart == 0.0f) {
-        return mipmapInterp(phase, buffer, startPos1, endPos1, spacing1, spacing2, crossfade);
+        return mipmapInterp<Interpolator>(phase, table, cycleIndex1, layer, crossfade);
     }
     
     // Calculate second cycle only when needed
-    const int cycleIndex2 = (intPart + 1) % numCycles;
-    const int startPos2 = cycleIndex2 * cycleSamples;
-    const int endPos2 = startPos2 + cycleSamples;
+    const int cycleIndex2 = (intPart + 1) % table.numCycles;
     
     // Process each cycle
-    float sig1 = mipmapInterp(phase, buffer, startPos1, endPos1, spacing1, spacing2, crossfade);
-    float sig2 = mipmapInterp(phase, buffer, startPos2, endPos2, spacing1, spacing2, crossfade);
+    float sig1 = mipmapInterp<Interpolator>(phase, table, cycleIndex1, layer, crossfade);
+    float sig2 = mipmapInterp<Interpolator>(phase, table, cycleIndex2, layer, crossfade);
     
     // Crossfade between the two cycles
     return lininterp(fracPart, sig1, sig2);
@@ -179,16 +637,17 @@ struct DualOsc {
         float oscB;
     };
     
+    template<typename Interpolator>
     Output process(
         float phaseA, float phaseB,
         float cyclePosA, float cyclePosB,
         float slopeA, float slopeB,
         float pmIndexA, float pmIndexB,
         float pmFilterRatioA, float pmFilterRatioB,
-        int spacing1A, int spacing2A, float crossfadeA,
-        int spacing1B, int spacing2B, float crossfadeB,
-        const float* bufferA, int cycleSamplesA, int numCyclesA,
-        const float* bufferB, int cycleSamplesB, int numCyclesB
+        int layerA, float crossfadeA,
+        int layerB, float crossfadeB,
+        const Wavetable& tableA,
+        const Wavetable& tableB
     ) {
 
         // Filter previous outputs with tracking OnePole filter
@@ -200,10 +659,8 @@ struct DualOsc {
         float modulatedPhaseB = sc_frac(phaseB + (filteredA / Utils::TWO_PI * pmIndexB));
 
         // Generate oscillator outputs
-        float oscA = wavetableOsc(modulatedPhaseA, bufferA, cycleSamplesA, numCyclesA, cyclePosA, 
-                                         spacing1A, spacing2A, crossfadeA);
-        float oscB = wavetableOsc(modulatedPhaseB, bufferB, cycleSamplesB, numCyclesB, cyclePosB, 
-                                         spacing1B, spacing2B, crossfadeB);
+        float oscA = wavetableOsc<Interpolator>(modulatedPhaseA, tableA, cyclePosA, layerA, crossfadeA);
+        float oscB = wavetableOsc<Interpolator>(modulatedPhaseB, tableB, cyclePosB, layerB, crossfadeB);
         
         // Store current outputs for next sample
         m_prevOscA = oscA;
@@ -235,16 +692,17 @@ struct DualOscScaled {
         float oscB;
     };
     
+    template<typename Interpolator>
     Output process(
         float phaseA, float phaseB,
         float cyclePosA, float cyclePosB,
         float slopeA, float slopeB,
         float pmIndexA, float pmIndexB,
         float pmFilterRatioA, float pmFilterRatioB,
-        int spacing1A, int spacing2A, float crossfadeA,
-        int spacing1B, int spacing2B, float crossfadeB,
-        const float* bufferA, int cycleSamplesA, int numCyclesA,
-        const float* bufferB, int cycleSamplesB, int numCyclesB
+        int layerA, float crossfadeA,
+        int layerB, float crossfadeB,
+        const Wavetable& tableA,
+        const Wavetable& tableB
     ) {
 
         // Filter previous outputs with tracking OnePole filter
@@ -266,10 +724,8 @@ struct DualOscScaled {
         float modulatedPhaseB = sc_frac(phaseB + (filteredA / Utils::TWO_PI * modRatioB * pmIndexB));
 
         // Generate oscillator outputs
-        float oscA = wavetableOsc(modulatedPhaseA, bufferA, cycleSamplesA, numCyclesA, cyclePosA,
-                                  spacing1A, spacing2A, crossfadeA);
-        float oscB = wavetableOsc(modulatedPhaseB, bufferB, cycleSamplesB, numCyclesB, cyclePosB,
-                                  spacing1B, spacing2B, crossfadeB);
+        float oscA = wavetableOsc<Interpolator>(modulatedPhaseA, tableA, cyclePosA, layerA, crossfadeA);
+        float oscB = wavetableOsc<Interpolator>(modulatedPhaseB, tableB, cyclePosB, layerB, crossfadeB);
         
         // Store current outputs for next sample
         m_prevOscA = oscA;
@@ -2,103 +2,806 @@
 #include "FilterUtils.hpp"
 #include <array>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace OversamplingUtils {
 
-// ===== HIGH-ORDER BUTTERWORTH LOWPASS =====
+// Half-band filter design of the oversampling cascade
+enum class FilterDesign {
+    MinimumPhase = 0,   // polyphase IIR allpass, low latency with frequency-dependent phase
+    LinearPhase         // windowed FIR, constant group delay at the cost of latency
+};
+
+inline FilterDesign resolveFilterDesign(float value) {
+    return static_cast<int>(value) == 1 ? FilterDesign::LinearPhase : FilterDesign::MinimumPhase;
+}
+
+// ===== POLYPHASE HALF-BAND FILTER =====
+
+// Half-band lowpass built from two parallel chains of first-order allpass sections in z^-2.
+// Both chains run at the lower of the two rates, so upsampling never filters stuffed zeros
+// and downsampling only computes the retained outputs.
+struct HalfbandFilter {
+    static constexpr int MAX_COEFS = 10;
+
+    std::array<float, MAX_COEFS> coefs{};
+    std::array<float, MAX_COEFS> x{};
+    std::array<float, MAX_COEFS> y{};
+    int numCoefs{0};
+
+    HalfbandFilter() = default;
 
-template<int NumBiquads>
-struct AAFilter {
-    std::array<FilterUtils::BiquadFilter, NumBiquads> filters;
-    std::array<FilterUtils::BiquadCoefficients, NumBiquads> coeffs;
+    // Elliptic design of the allpass coefficients (Valenzuela & Constantinides),
+    // transition bandwidth is normalized to the higher rate and centered on its quarter
+    void design(int order, double transition) {
+        numCoefs = sc_clip(order, 1, MAX_COEFS);
 
-    AAFilter() = default;
+        double k = std::tan((1.0 - transition * 2.0) * Utils::PI / 4.0);
+        k *= k;
+        const double kksqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+        const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
 
-    // Calculate Q values for Butterworth filter of given order
-    static std::array<float, NumBiquads> calculateButterQs(int order) {
-        std::array<float, NumBiquads> Qs{};
+        const int filterOrder = numCoefs * 2 + 1;
+        for (int index = 0; index < numCoefs; ++index) {
+            const int c = index + 1;
 
-        const int lim = order / 2;
+            // Theta function series for the pole positions
+            double num = 0.0;
+            double term = 0.0;
+            int i = 0;
+            do {
+                term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * Utils::PI / filterOrder);
+                num += (i & 1) ? -term : term;
+                ++i;
+            } while (std::abs(term) > 1e-100);
 
-        for (int k = 1; k <= lim; ++k) {
-            float t = static_cast<float>(2 * k + order - 1);
-            float alpha = -2.0f * std::cos(Utils::PI * t / (2.0f * static_cast<float>(order)));
-            Qs[lim - k] = 1.0f / alpha;
+            double den = 0.0;
+            i = 1;
+            do {
+                term = std::pow(q, i * i) * std::cos(i * 2 * c * Utils::PI / filterOrder);
+                den += (i & 1) ? -term : term;
+                ++i;
+            } while (std::abs(term) > 1e-100);
+
+            const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+            const double wwsq = ww * ww;
+            const double xx = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            coefs[index] = static_cast<float>((1.0 - xx) / (1.0 + xx));
+        }
+
+        reset();
+    }
+
+    // Run both allpass chains, even coefficients on path 0 and odd coefficients on path 1
+    static inline void processPaths(const float* c, float* sx, float* sy, int numCoefs, float& path0, float& path1) {
+        for (int i = 0; i < numCoefs; i += 2) {
+            const float out = (path0 - sy[i]) * c[i] + sx[i];
+            sx[i] = path0;
+            sy[i] = out;
+            path0 = out;
+        }
+        for (int i = 1; i < numCoefs; i += 2) {
+            const float out = (path1 - sy[i]) * c[i] + sx[i];
+            sx[i] = path1;
+            sy[i] = out;
+            path1 = out;
         }
+    }
+
+    // n input samples to 2n output samples at twice the rate, the state stays local for the
+    // whole span. The input may sit in the upper half of the output, it is read ahead of the writes
+    inline void upsampleBlock(const float* input, float* output, int n) {
+        const std::array<float, MAX_COEFS> c = coefs;
+        std::array<float, MAX_COEFS> sx = x;
+        std::array<float, MAX_COEFS> sy = y;
+
+        for (int j = 0; j < n; ++j) {
+            float path0 = input[j];
+            float path1 = path0;
+            processPaths(c.data(), sx.data(), sy.data(), numCoefs, path0, path1);
+            output[2 * j] = path0;
+            output[2 * j + 1] = path1;
+        }
+
+        x = sx;
+        y = sy;
+    }
+
+    // 2n input samples to n output samples at half the rate, the output may alias the input
+    inline void downsampleBlock(const float* input, float* output, int n) {
+        const std::array<float, MAX_COEFS> c = coefs;
+        std::array<float, MAX_COEFS> sx = x;
+        std::array<float, MAX_COEFS> sy = y;
+
+        for (int j = 0; j < n; ++j) {
+            float path0 = input[2 * j + 1];
+            float path1 = input[2 * j];
+            processPaths(c.data(), sx.data(), sy.data(), numCoefs, path0, path1);
+            output[j] = 0.5f * (path0 + path1);
+        }
+
+        x = sx;
+        y = sy;
+    }
 
-        return Qs;
+    void reset() {
+        x.fill(0.0f);
+        y.fill(0.0f);
+    }
+
+    // Steady state for a constant input, used when an idle stage is switched back in
+    void prime(float value) {
+        x.fill(value);
+        y.fill(value);
+    }
+
+    // Group delay at DC in samples of the higher rate. Each section in z^-2 delays DC by
+    // 2 * (1 - a) / (1 + a), the half-band averages both paths plus the one sample between them
+    double groupDelay() const {
+        double path0 = 0.0;
+        double path1 = 1.0;
+        for (int i = 0; i < numCoefs; ++i) {
+            const double delay = 2.0 * (1.0 - coefs[i]) / (1.0 + coefs[i]);
+            if (i & 1) {
+                path1 += delay;
+            } else {
+                path0 += delay;
+            }
+        }
+        return 0.5 * (path0 + path1);
     }
+};
+
+// ===== LINEAR-PHASE HALF-BAND FILTER =====
+
+// Kaiser-windowed half-band FIR. Apart from the center all even taps of a half-band are zero,
+// so one polyphase branch is a pure delay and the other a symmetric sum over numTaps pairs.
+// The group delay is 2 * numTaps - 1 samples at the higher rate for all frequencies.
+struct HalfbandFIR {
+    static constexpr int MAX_TAPS = 32;
+    static constexpr int RING_SIZE = MAX_TAPS * 2;
 
-    // Calculate filter coefficients
-    void calculate(float sampleRate, int osRatio) {
+    std::array<float, MAX_TAPS> coefs{};
 
-        // Calculate Q values
-        auto Qs = calculateButterQs(2 * NumBiquads);
+    // Doubled rings, so the last 2 * numTaps inputs are always one contiguous window
+    std::array<float, RING_SIZE * 2> odd{};
+    std::array<float, RING_SIZE * 2> even{};
+    int numTaps{0};
+    int pos{0};
 
-        const float nyquist = sampleRate * 0.49f;
-        const float osRate  = sampleRate * static_cast<float>(osRatio);
+    HalfbandFIR() = default;
+
+    // Windowed sinc with cutoff at a quarter of the higher rate, normalized to unity gain at DC
+    void design(int taps, double beta) {
+        numTaps = sc_clip(taps, 1, MAX_TAPS);
+
+        const double halfLength = static_cast<double>(numTaps * 2);
+        double sum = 0.0;
+        for (int k = 0; k < numTaps; ++k) {
+            const int n = 2 * k + 1;
+            const double sinc = std::sin(n * Utils::PI * 0.5) / (n * Utils::PI);
+            const double ratio = n / halfLength;
+            const double window = besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta);
+            coefs[k] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
 
-        for (int i = 0; i < NumBiquads; ++i) {
-            coeffs[i] = FilterUtils::BiquadCoefficients::lowpass(nyquist, Qs[i], osRate);
+        // The delay branch carries half the DC gain, the tap pairs the other half
+        for (int k = 0; k < numTaps; ++k) {
+            coefs[k] = static_cast<float>(coefs[k] * 0.25 / sum);
+        }
+
+        reset();
+    }
+
+    // n input samples to 2n output samples at twice the rate, the input may sit in the upper
+    // half of the output as it is read ahead of the writes
+    inline void upsampleBlock(const float* input, float* output, int n) {
+        for (int j = 0; j < n; ++j) {
+            const float* window = push(odd, input[j]);
+            advance();
+
+            output[2 * j] = 2.0f * tapSum(window);
+            output[2 * j + 1] = window[numTaps];
         }
     }
 
-    // Process audio through high-order lowpass filter
-    inline float process(float input) {
+    // 2n input samples to n output samples at half the rate, the output may alias the input
+    inline void downsampleBlock(const float* input, float* output, int n) {
+        for (int j = 0; j < n; ++j) {
+            const float* evenWindow = push(even, input[2 * j]);
+            const float* oddWindow = push(odd, input[2 * j + 1]);
+            advance();
 
-        // Cascade lowpass filters
-        float processed = input;
-        for (int i = 0; i < NumBiquads; ++i) {
-            processed = filters[i].process(processed, coeffs[i]);
+            output[j] = 0.5f * evenWindow[numTaps] + tapSum(oddWindow);
         }
+    }
 
-        return processed;
+    double groupDelay() const {
+        return static_cast<double>(numTaps * 2 - 1);
     }
 
     void reset() {
-        for (int i = 0; i < NumBiquads; ++i) {
-            filters[i].reset();
+        odd.fill(0.0f);
+        even.fill(0.0f);
+        pos = 0;
+    }
+
+    // Steady state for a constant input, used when an idle stage is switched back in
+    void prime(float value) {
+        odd.fill(value);
+        even.fill(value);
+    }
+
+private:
+    // Write the newest sample and return the window of the last 2 * numTaps, oldest first
+    inline const float* push(std::array<float, RING_SIZE * 2>& ring, float value) {
+        const int size = numTaps * 2;
+        ring[pos] = value;
+        ring[pos + size] = value;
+        return ring.data() + pos + 1;
+    }
+
+    inline void advance() {
+        pos = (pos + 1 == numTaps * 2) ? 0 : pos + 1;
+    }
+
+    // Symmetric tap pairs around the center of the window
+    inline float tapSum(const float* window) const {
+        float sum = 0.0f;
+        for (int k = 0; k < numTaps; ++k) {
+            sum += coefs[k] * (window[numTaps + k] + window[numTaps - 1 - k]);
+        }
+        return sum;
+    }
+
+    // Modified Bessel function of the first kind, order zero (power series)
+    static double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        const double halfX = x * 0.5;
+        for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
         }
+        return sum;
     }
 };
 
 // ===== VARIABLE OVERSAMPLING =====
 
+// Cascade of 2x half-band stages up to 16x. Stage 0 sits next to the base rate and needs the
+// steepest transition, later stages only have to reject images above the base band.
 struct VariableOversampling {
-    AAFilter<4> aaFilter;
-    AAFilter<4> aiFilter;
-    
-    float* m_osBuffer{nullptr};
+    static constexpr int MAX_STAGES = 4;
+    static constexpr int MAX_RATIO = 1 << MAX_STAGES;
+
+    // Allpass coefficients per stage and transition bandwidths (~100 dB stage 0, >70 dB after)
+    static constexpr std::array<int, MAX_STAGES> STAGE_ORDERS{10, 4, 3, 3};
+    static constexpr std::array<double, MAX_STAGES> STAGE_TRANSITIONS{0.02, 0.125, 0.1875, 0.21875};
+
+    // Linear-phase alternative: tap pairs per stage and Kaiser beta (~100 dB stopband)
+    static constexpr std::array<int, MAX_STAGES> FIR_STAGE_TAPS{32, 7, 5, 4};
+    static constexpr double FIR_KAISER_BETA = 10.0;
+
+    // Linear-phase stages are several times the size of the allpass stages. They are held outside
+    // the cascade and only allocated by units which choose that design
+    struct FIRStages {
+        std::array<HalfbandFIR, MAX_STAGES> up;
+        std::array<HalfbandFIR, MAX_STAGES> down;
+    };
+
+    std::array<HalfbandFilter, MAX_STAGES> upStages;
+    std::array<HalfbandFilter, MAX_STAGES> downStages;
+    FIRStages* m_firStages{nullptr};
+
+    FilterDesign m_design{FilterDesign::MinimumPhase};
     int m_osRatio{1};
- 
+    int m_numStages{0};
+    int m_maxStages{0};
+
+    // Stages below these counts have run without a break and hold valid state
+    int m_primedUpStages{0};
+    int m_primedDownStages{0};
+
+    // Ring of the last samples of one signal in the decimation cascade
+    static constexpr int HISTORY_SIZE = 64;
+    static constexpr double MAX_GLIDE = HISTORY_SIZE - 4;
+
+    struct History {
+        std::array<float, HISTORY_SIZE> samples{};
+        int pos{0};
+
+        void push(float value) {
+            samples[pos] = value;
+            pos = (pos + 1) & (HISTORY_SIZE - 1);
+        }
+
+        // Sample pushed the given number of pushes ago, starting at 1
+        float back(int count) const {
+            return samples[(pos - sc_min(count, HISTORY_SIZE)) & (HISTORY_SIZE - 1)];
+        }
+    };
+
+    // Signals entering each decimation stage and leaving the cascade, indexed by the exponent of
+    // their rate. A ratio change glides out its latency change at the highest rate both ratios run
+    std::array<History, MAX_STAGES + 1> m_history;
+    int m_glideLevel{0};
+    double m_pendingGlide{0.0};
+    double m_blockGlide{0.0};
+
     VariableOversampling() = default;
- 
-    // Initialize oversampling filters
-    void init(int osRatio, float sampleRate, float* osBuffer) {
-        m_osRatio = osRatio;
-        m_osBuffer = osBuffer;
-        aaFilter.calculate(sampleRate, osRatio);
-        aiFilter.calculate(sampleRate, osRatio);
-    }
- 
-    // Process anti-imaging filter
-    inline void upsample(float x) {
-        m_osBuffer[0] = static_cast<float>(m_osRatio) * x;
-        memset(m_osBuffer + 1, 0, (m_osRatio - 1) * sizeof(float));
- 
-        for (int k = 0; k < m_osRatio; ++k) {
-            m_osBuffer[k] = aiFilter.process(m_osBuffer[k]);
-        }
-    }
- 
-    // Process anti-aliasing filter
-    inline float downsample() {
-        float y = 0.0f;
-        for (int k = 0; k < m_osRatio; ++k) {
-            y = aaFilter.process(m_osBuffer[k]);
-        }
-        return y;
+
+    // Initialize oversampling filters, the half-band design is independent of the sample rate.
+    // The linear-phase design runs on the given FIR stages and falls back to minimum phase without
+    void init(int osRatio, FilterDesign design = FilterDesign::MinimumPhase, FIRStages* firStages = nullptr) {
+        m_firStages = firStages;
+        m_design = firStages ? design : FilterDesign::MinimumPhase;
+        m_osRatio = sc_clip(osRatio, 1, MAX_RATIO);
+        m_numStages = stagesForRatio(m_osRatio);
+        m_maxStages = m_numStages;
+        m_primedUpStages = m_numStages;
+        m_primedDownStages = m_numStages;
+
+        for (int s = 0; s < m_numStages; ++s) {
+            if (m_design == FilterDesign::LinearPhase) {
+                m_firStages->up[s].design(FIR_STAGE_TAPS[s], FIR_KAISER_BETA);
+                m_firStages->down[s] = m_firStages->up[s];
+            } else {
+                upStages[s].design(STAGE_ORDERS[s], STAGE_TRANSITIONS[s]);
+                downStages[s] = upStages[s];
+            }
+        }
+    }
+
+    // Change the active ratio up to the initialized one. Each stage always runs between the same
+    // two rates, so stages in use keep their state and stages switched back in are primed.
+    // The change in latency is glided out over the next decimated block instead of a jump
+    void setRatio(int osRatio) {
+        const int previousStages = m_numStages;
+        const double previousLatency = downsampleLatency();
+
+        m_osRatio = sc_clip(osRatio, 1, 1 << m_maxStages);
+        m_numStages = stagesForRatio(m_osRatio);
+        m_primedUpStages = sc_min(m_primedUpStages, m_numStages);
+        m_primedDownStages = sc_min(m_primedDownStages, m_numStages);
+
+        if (m_numStages != previousStages) {
+            const int sharedStages = sc_min(previousStages, m_numStages);
+            m_glideLevel = m_pendingGlide != 0.0 ? sc_min(m_glideLevel, sharedStages) : sharedStages;
+            m_pendingGlide += previousLatency - downsampleLatency();
+        }
+    }
+
+    static int stagesForRatio(int osRatio) {
+        int numStages = 0;
+        while ((1 << numStages) < osRatio) {
+            ++numStages;
+        }
+        return numStages;
+    }
+
+    // Delays of the cascade at the active ratio in base-rate samples, exact for the linear-phase
+    // design and taken at DC for the minimum-phase design. Stage s runs at 2^(s + 1) times the
+    // base rate. Decimation keeps the even phase, which is one high-rate sample ahead of the odd one
+    double upsampleLatency() const {
+        double latency = 0.0;
+        for (int s = 0; s < m_numStages; ++s) {
+            latency += stageDelay(s) / static_cast<double>(2 << s);
+        }
+        return latency;
+    }
+
+    double downsampleLatency() const {
+        double latency = 0.0;
+        for (int s = 0; s < m_numStages; ++s) {
+            latency += (stageDelay(s) - 1.0) / static_cast<double>(2 << s);
+        }
+        return latency;
+    }
+
+    // Delay of a full upsample and downsample round trip in base-rate samples
+    double latency() const {
+        return upsampleLatency() + downsampleLatency();
+    }
+
+    // Delay of the last decimated block per sample, including a latency change being glided out
+    void downsampleLatencyBlock(float* output, int nSamples) const {
+        const double latency = downsampleLatency();
+        for (int i = 0; i < nSamples; ++i) {
+            output[i] = static_cast<float>(latency + glideOffset(m_blockGlide, i, nSamples));
+        }
+    }
+
+    double stageDelay(int stage) const {
+        return m_design == FilterDesign::LinearPhase ?
+            m_firStages->up[stage].groupDelay() :
+            upStages[stage].groupDelay();
+    }
+
+    // Interpolate nSamples of input into nSamples * m_osRatio samples of output, stage by stage.
+    // Each stage expands from the tail of the output towards its start, so the input may alias it
+    inline void upsampleBlock(const float* input, float* output, int nSamples) {
+        const int total = nSamples * m_osRatio;
+        float* stageInput = output + total - nSamples;
+        std::memmove(stageInput, input, nSamples * sizeof(float));
+
+        int n = nSamples;
+        for (int s = 0; s < m_numStages; ++s) {
+            float* stageOutput = output + total - 2 * n;
+            if (m_design == FilterDesign::LinearPhase) {
+                if (s >= m_primedUpStages) {
+                    m_firStages->up[s].prime(stageInput[0]);
+                }
+                m_firStages->up[s].upsampleBlock(stageInput, stageOutput, n);
+            } else {
+                if (s >= m_primedUpStages) {
+                    upStages[s].prime(stageInput[0]);
+                }
+                upStages[s].upsampleBlock(stageInput, stageOutput, n);
+            }
+            stageInput = stageOutput;
+            n *= 2;
+        }
+        m_primedUpStages = m_numStages;
+    }
+
+    // Decimate nSamples * m_osRatio samples of input into nSamples of output, stage by stage.
+    // Intermediate stages are decimated in place, so the input is overwritten
+    inline void downsampleBlock(float* input, float* output, int nSamples) {
+
+        // Latency change of this block in samples at the rate it is glided out at
+        const int glideLevel = m_glideLevel;
+        const double glide = sc_clip(m_pendingGlide * static_cast<double>(1 << glideLevel), -MAX_GLIDE, MAX_GLIDE);
+        m_blockGlide = glide / static_cast<double>(1 << glideLevel);
+        m_pendingGlide = 0.0;
+
+        int n = nSamples * m_osRatio;
+        for (int s = m_numStages - 1; s >= 0; --s) {
+            if (glide != 0.0 && s + 1 == glideLevel) {
+                glideBlock(m_history[s + 1], input, n, glide);
+            } else {
+                pushTail(m_history[s + 1], input, n);
+            }
+
+            n /= 2;
+            float* stageOutput = s == 0 ? output : input;
+            if (m_design == FilterDesign::LinearPhase) {
+                if (s >= m_primedDownStages) {
+                    primeStage(m_firStages->down[s], input, n);
+                }
+                m_firStages->down[s].downsampleBlock(input, stageOutput, n);
+            } else {
+                if (s >= m_primedDownStages) {
+                    primeStage(downStages[s], input, n);
+                }
+                downStages[s].downsampleBlock(input, stageOutput, n);
+            }
+        }
+        m_primedDownStages = m_numStages;
+
+        if (m_numStages == 0) {
+            std::memmove(output, input, nSamples * sizeof(float));
+        }
+
+        if (glide != 0.0 && glideLevel == 0) {
+            glideBlock(m_history[0], output, nSamples, glide);
+        } else {
+            pushTail(m_history[0], output, nSamples);
+        }
+    }
+
+private:
+    // Prime a decimation stage switched back in by running it over the point reflection of its
+    // first block, which continues the input backwards with matching value and slope
+    template<typename Stage>
+    static void primeStage(Stage& stage, const float* input, int n) {
+        static constexpr int CHUNK = 32;
+        std::array<float, CHUNK * 2> reflected;
+        std::array<float, CHUNK> discarded;
+
+        const float pivot = 2.0f * input[0];
+        const int numPairs = n - 1;
+        stage.prime(pivot - input[2 * numPairs]);
+
+        for (int start = numPairs; start > 0; start -= CHUNK) {
+            const int count = sc_min(CHUNK, start);
+            for (int j = 0; j < count; ++j) {
+                const int back = 2 * (start - j);
+                reflected[2 * j] = pivot - input[back];
+                reflected[2 * j + 1] = pivot - input[back - 1];
+            }
+            stage.downsampleBlock(reflected.data(), discarded.data(), count);
+        }
+    }
+
+    // Extra delay at sample i of a glide block, reaching zero on its last sample
+    static inline double glideOffset(double glide, int i, int count) {
+        return glide * (1.0 - static_cast<double>(i + 1) / static_cast<double>(count));
+    }
+
+    static inline void pushTail(History& history, const float* signal, int count) {
+        for (int i = sc_max(count - HISTORY_SIZE, 0); i < count; ++i) {
+            history.push(signal[i]);
+        }
+    }
+
+    // Read a block of the signal through a delay gliding from the latency change to zero, so the
+    // stages after it see a continuous input. Samples before the block ran at the previous ratio
+    // and are shifted into the frame of the new one. A drop in latency leaves samples which
+    // neither ratio produced, that gap is bridged linearly
+    static inline void glideBlock(History& history, float* signal, int count, double glide) {
+        for (int i = 0; i < count; ++i) {
+
+            // Sample at block index k, samples already replaced come from the ring
+            auto original = [&](int k) {
+                return k >= i ? signal[sc_min(k, count - 1)] : history.back(i - k);
+            };
+
+            // Sample at block index k in the frame of the new ratio
+            auto framed = [&](int k) {
+                if (k >= 0) {
+                    return original(k);
+                }
+                const double previousPos = static_cast<double>(k) + glide;
+                if (previousPos <= -1.0) {
+                    const double floorPos = std::floor(previousPos);
+                    const int index = static_cast<int>(floorPos);
+                    return lininterp(static_cast<float>(previousPos - floorPos), original(index), original(index + 1));
+                }
+                const double gapPos = (previousPos + 1.0) / (glide + 1.0);
+                return lininterp(static_cast<float>(gapPos), original(-1), original(0));
+            };
+
+            const double readPos = static_cast<double>(i) - glideOffset(glide, i, count);
+            const double floorPos = std::floor(readPos);
+            const int index = static_cast<int>(floorPos);
+            const float frac = static_cast<float>(readPos - floorPos);
+
+            const float value = cubicinterp(frac, framed(index - 1), framed(index), framed(index + 1), framed(index + 2));
+            history.push(signal[i]);
+            signal[i] = value;
+        }
+    }
+};
+
+// ===== MULTI-CHANNEL OVERSAMPLING =====
+
+// Upsamples several parameter blocks at once. Channels flagged as linear (control-rate inputs)
+// are ramped across the oversampled sub-steps, which cannot overshoot. The remaining channels run
+// through one half-band cascade with one channel per lane, sharing the stage coefficients so each
+// allpass section runs on whole lane vectors. Lanes are padded to a multiple of 4.
+template<int NumChannels>
+struct MultiChannelOversampling {
+    static constexpr int LANES = (NumChannels + 3) & ~3;
+    static constexpr int MAX_COEFS = HalfbandFilter::MAX_COEFS;
+
+    using Lanes = std::array<float, LANES>;
+    using Channels = std::array<float*, NumChannels>;
+
+    struct Stage {
+        std::array<float, MAX_COEFS> coefs{};
+        std::array<Lanes, MAX_COEFS> x{};
+        std::array<Lanes, MAX_COEFS> y{};
+        int numCoefs{0};
+    };
+
+    std::array<Stage, VariableOversampling::MAX_STAGES> upStages;
+
+    std::array<bool, NumChannels> m_linear{};
+    std::array<float, NumChannels> m_lastValues{};
+    std::array<int, NumChannels> m_filteredChannels{};
+    int m_numFiltered{0};
+
+    int m_osRatio{1};
+    int m_numStages{0};
+    int m_maxStages{0};
+    int m_primedStages{0};
+
+    MultiChannelOversampling() = default;
+
+    // Initialize the shared stage coefficients from the single-channel cascade design,
+    // linear channels start their first ramp from their initial values
+    void init(int osRatio,
+              const std::array<bool, NumChannels>& linear,
+              const std::array<float, NumChannels>& initialValues) {
+        VariableOversampling design;
+        design.init(osRatio);
+
+        m_osRatio = design.m_osRatio;
+        m_numStages = design.m_numStages;
+        m_maxStages = m_numStages;
+        m_primedStages = m_numStages;
+
+        for (int s = 0; s < m_numStages; ++s) {
+            upStages[s] = Stage{};
+            upStages[s].coefs = design.upStages[s].coefs;
+            upStages[s].numCoefs = design.upStages[s].numCoefs;
+        }
+
+        m_linear = linear;
+        m_lastValues = initialValues;
+        m_numFiltered = 0;
+        for (int c = 0; c < NumChannels; ++c) {
+            if (!m_linear[c]) {
+                m_filteredChannels[m_numFiltered++] = c;
+            }
+        }
+    }
+
+    // Change the active ratio up to the initialized one, stages switched back in are primed
+    void setRatio(int osRatio) {
+        m_osRatio = sc_clip(osRatio, 1, 1 << m_maxStages);
+        m_numStages = VariableOversampling::stagesForRatio(m_osRatio);
+        m_primedStages = sc_min(m_primedStages, m_numStages);
+    }
+
+    // True if any channel runs through the half-band cascade and may overshoot its input range
+    bool filtered() const {
+        return m_numFiltered > 0;
+    }
+
+    // Interpolate the first nSamples of every channel into nSamples * m_osRatio samples in place
+    inline void upsampleBlock(const Channels& channels, int nSamples) {
+        const int total = nSamples * m_osRatio;
+
+        for (int c = 0; c < NumChannels; ++c) {
+            if (m_linear[c]) {
+                rampBlock(channels[c], m_lastValues[c], nSamples);
+            }
+        }
+
+        if (m_numFiltered == 0) {
+            return;
+        }
+
+        // Filtered channels are packed into the lowest lanes
+        Channels filteredChannels{};
+        for (int l = 0; l < m_numFiltered; ++l) {
+            filteredChannels[l] = channels[m_filteredChannels[l]];
+            std::memmove(filteredChannels[l] + total - nSamples, filteredChannels[l], nSamples * sizeof(float));
+        }
+
+        int n = nSamples;
+        for (int s = 0; s < m_numStages; ++s) {
+            upsampleStage(upStages[s], filteredChannels, m_numFiltered, total - n, total - 2 * n, n,
+                          s >= m_primedStages);
+            n *= 2;
+        }
+        m_primedStages = m_numStages;
+    }
+
+private:
+    // Ramp from the previous base-rate value to the current one, reaching it on the last sub-step.
+    // Runs backwards so the base-rate values ahead of each write are still intact
+    inline void rampBlock(float* block, float& lastValue, int nSamples) const {
+        const float scale = 1.0f / static_cast<float>(m_osRatio);
+        const float blockLast = block[nSamples - 1];
+
+        for (int i = nSamples - 1; i >= 0; --i) {
+            const float current = block[i];
+            const float previous = i > 0 ? block[i - 1] : lastValue;
+            const float step = (current - previous) * scale;
+
+            float* subSteps = block + i * m_osRatio;
+            for (int k = 0; k < m_osRatio - 1; ++k) {
+                subSteps[k] = previous + step * static_cast<float>(k + 1);
+            }
+            subSteps[m_osRatio - 1] = current;
+        }
+
+        lastValue = blockLast;
+    }
+
+    // One 2x stage from channel offset inOffset to outOffset, the state stays local for the span
+    static inline void upsampleStage(Stage& stage, const Channels& channels, int numLanes,
+                                     int inOffset, int outOffset, int n, bool prime) {
+        const std::array<float, MAX_COEFS> c = stage.coefs;
+        std::array<Lanes, MAX_COEFS> sx = stage.x;
+        std::array<Lanes, MAX_COEFS> sy = stage.y;
+        const int numCoefs = stage.numCoefs;
+
+        // Stage switched back in: start from the steady state for its first input
+        if (prime) {
+            for (int i = 0; i < numCoefs; ++i) {
+                for (int l = 0; l < numLanes; ++l) {
+                    sx[i][l] = channels[l][inOffset];
+                    sy[i][l] = channels[l][inOffset];
+                }
+            }
+        }
+
+        for (int j = 0; j < n; ++j) {
+            Lanes path0{};
+            for (int l = 0; l < numLanes; ++l) {
+                path0[l] = channels[l][inOffset + j];
+            }
+            Lanes path1 = path0;
+
+            // Even coefficients on path 0 and odd coefficients on path 1
+            for (int i = 0; i < numCoefs; i += 2) {
+                for (int l = 0; l < LANES; ++l) {
+                    const float out = (path0[l] - sy[i][l]) * c[i] + sx[i][l];
+                    sx[i][l] = path0[l];
+                    sy[i][l] = out;
+                    path0[l] = out;
+                }
+            }
+            for (int i = 1; i < numCoefs; i += 2) {
+                for (int l = 0; l < LANES; ++l) {
+                    const float out = (path1[l] - sy[i][l]) * c[i] + sx[i][l];
+                    sx[i][l] = path1[l];
+                    sy[i][l] = out;
+                    path1[l] = out;
+                }
+            }
+
+            for (int l = 0; l < numLanes; ++l) {
+                channels[l][outOffset + 2 * j] = path0[l];
+                channels[l][outOffset + 2 * j + 1] = path1[l];
+            }
+        }
+
+        stage.x = sx;
+        stage.y = sy;
+    }
+};
+
+// ===== ADAPTIVE OVERSAMPLING =====
+
+// Oversample input value which picks the ratio per block, buffers are allocated for 16x
+constexpr int OVERSAMPLE_AUTO = 5;
+constexpr int MAX_OVERSAMPLE_INDEX = 4;
+
+inline bool isAutoOversample(float oversample) {
+    return static_cast<int>(oversample) == OVERSAMPLE_AUTO;
+}
+
+// Picks the oversampling index per block from the bandwidth an oscillator is expected to occupy,
+// estimated from its phase slope and PM index. Rising risk switches up at once, falling risk only
+// steps down once the bandwidth has stayed clearly below the lower threshold for a while, so the
+// ratio does not chatter around a threshold.
+struct AdaptiveRatio {
+    static constexpr float HARMONIC_SPAN = 32.0f;
+    static constexpr float HYSTERESIS = 1.5f;
+    static constexpr int HOLD_BLOCKS = 16;
+
+    int m_index{0};
+    int m_holdCount{0};
+
+    AdaptiveRatio() = default;
+
+    // slope: largest phase increment per sample in the block, modIndex: largest PM index
+    int process(float slope, float modIndex) {
+        const float bandwidth = sc_abs(slope) * HARMONIC_SPAN * (1.0f + modIndex);
+
+        if (indexFor(bandwidth) > m_index) {
+            m_index = indexFor(bandwidth);
+            m_holdCount = 0;
+        } else if (indexFor(bandwidth * HYSTERESIS) < m_index) {
+            if (++m_holdCount >= HOLD_BLOCKS) {
+                --m_index;
+                m_holdCount = 0;
+            }
+        } else {
+            m_holdCount = 0;
+        }
+
+        return m_index;
+    }
+
+private:
+    // Smallest index whose Nyquist covers the bandwidth
+    static int indexFor(float bandwidth) {
+        int index = 0;
+        while (index < MAX_OVERSAMPLE_INDEX && bandwidth > 0.5f * static_cast<float>(1 << index)) {
+            ++index;
+        }
+        return index;
     }
 };
 
-} // namespace OversamplingUtils
\ No newline at end of file
+} // namespace OversamplingUtils
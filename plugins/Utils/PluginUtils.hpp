@@ -1,24 +1,81 @@
 #pragma once
 #include "SC_PlugIn.hpp"
 #include <limits>
+#include <cstdint>
 #include <cstring>
+#include <new>
 
 extern InterfaceTable* ft;
 
 namespace PluginUtils {
 
-// ===== BUFFER ALLOCATION =====
+// ===== ARENA ALLOCATION =====
 
-inline void allocBuffer(Unit* unit, World* world, int numSamples, float*& buffer) {
-    // Allocate audio buffer
-    buffer = (float*)RTAlloc(world, numSamples * sizeof(float));
+// All buffers and objects of a unit carved out of a single RTAlloc, freed at once. The layout
+// callback runs twice: a sizing pass which hands out null pointers, then a pass over the allocated
+// block. Every region starts on a 64-byte boundary and is zero-initialized.
+class RTArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
 
-    // Check the result of RTAlloc!
-    ClearUnitIfMemFailed(buffer);
-    
-    // Initialize the allocated buffer with zeros
-    memset(buffer, 0, numSamples * sizeof(float));
-}
+    RTArena() = default;
+
+    template<typename Layout>
+    void allocate(Unit* unit, World* world, Layout&& layout) {
+        // Sizing pass
+        m_base = nullptr;
+        m_offset = 0;
+        layout(*this);
+        const size_t size = m_offset;
+
+        // RTAlloc gives no alignment guarantee for SIMD, over-allocate and align the base
+        m_memory = RTAlloc(world, size + ALIGNMENT - 1);
+
+        // Check the result of RTAlloc!
+        ClearUnitIfMemFailed(m_memory);
+
+        m_base = reinterpret_cast<char*>(alignUp(reinterpret_cast<uintptr_t>(m_memory)));
+        memset(m_base, 0, size);
+
+        // Partition pass
+        m_offset = 0;
+        layout(*this);
+    }
+
+    template<typename T>
+    T* buffer(int count) {
+        static_assert(alignof(T) <= ALIGNMENT, "RTArena: type needs stronger alignment");
+        T* region = m_base ? reinterpret_cast<T*>(m_base + m_offset) : nullptr;
+        m_offset += alignUp(static_cast<size_t>(count) * sizeof(T));
+        return region;
+    }
+
+    // Default-constructed object, destructors are not run so T should be trivially destructible
+    template<typename T>
+    T* object() {
+        T* region = buffer<T>(1);
+        return region ? new (region) T() : nullptr;
+    }
+
+    bool valid() const {
+        return m_base != nullptr;
+    }
+
+    void free(World* world) {
+        RTFree(world, m_memory);
+        m_memory = nullptr;
+        m_base = nullptr;
+    }
+
+private:
+    static constexpr uintptr_t alignUp(uintptr_t value) {
+        return (value + ALIGNMENT - 1) & ~static_cast<uintptr_t>(ALIGNMENT - 1);
+    }
+
+    void* m_memory{nullptr};
+    char* m_base{nullptr};
+    size_t m_offset{0};
+};
 
 // ===== BUFFER MANAGEMENT =====
 
@@ -1,9 +1,22 @@
 #pragma once
 #include "SC_PlugIn.hpp"
 #include <array>
+#include <cstdint>
 #include <cmath>  
 #include <algorithm>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define GRAINUTILS_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define GRAINUTILS_NEON 1
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
 namespace Utils {
 
 // ===== CONSTANTS =====
@@ -20,6 +33,16 @@ inline float cosInterp(float x, float a, float b) {
     return lininterp(mix, a, b);
 }
 
+// Hanning window as sin(pi * x)^2, with sin(pi * x) = cos(pi * (x - 0.5)) from an even Taylor polynomial (error < 5e-7)
+inline constexpr float HANNING_POLY[5] = {-4.9348022005f, 4.0587121264f, -1.3352627689f, 0.23533063036f, -0.025806891390f};
+
+inline float hanningWindow(float phase) {
+    const float y = sc_clip(phase, 0.0f, 1.0f) - 0.5f;
+    const float z = y * y;
+    const float c = 1.0f + z * (HANNING_POLY[0] + z * (HANNING_POLY[1] + z * (HANNING_POLY[2] + z * (HANNING_POLY[3] + z * HANNING_POLY[4]))));
+    return c * c;
+}
+
 // ===== PANNING UTILITIES =====
 
 struct EqualPowerPan {
@@ -60,16 +83,14 @@ inline float peekLinearInterp(const float* buffer, float phase, int mask) {
     return lininterp(fracPart, a, b);
 }
 
-// Fast cubic interpolation peek with bitwise wrapping - (for power-of-2 sizes)
-inline float peekCubicInterp(const float* buffer, float phase, int mask) {
+// Fast cubic interpolation peek at an integer index plus fraction with bitwise wrapping - (for power-of-2 sizes).
+// Keeps the fraction exact on buffers too long for a float position
+inline float peekCubicInterp(const float* buffer, int index, float fracPart, int mask) {
     
-    const int intPart = static_cast<int>(phase);
-    const float fracPart = phase - static_cast<float>(intPart);
-    
-    const int idx0 = (intPart - 1) & mask;
-    const int idx1 = intPart & mask;
-    const int idx2 = (intPart + 1) & mask;
-    const int idx3 = (intPart + 2) & mask;
+    const int idx0 = (index - 1) & mask;
+    const int idx1 = index & mask;
+    const int idx2 = (index + 1) & mask;
+    const int idx3 = (index + 2) & mask;
     
     const float a = buffer[idx0];
     const float b = buffer[idx1];
@@ -79,8 +100,167 @@ inline float peekCubicInterp(const float* buffer, float phase, int mask) {
     return cubicinterp(fracPart, a, b, c, d);
 }
 
+// Fast cubic interpolation peek with bitwise wrapping - (for power-of-2 sizes)
+inline float peekCubicInterp(const float* buffer, float phase, int mask) {
+    
+    const int intPart = static_cast<int>(phase);
+    const float fracPart = phase - static_cast<float>(intPart);
+    
+    return peekCubicInterp(buffer, intPart, fracPart, mask);
+}
+
+// ===== SIMD UTILITIES =====
+
+// Dot product of two float arrays, N has to be a multiple of 4
+template<int N>
+inline float dotProduct(const float* a, const float* b) {
+    static_assert(N % 4 == 0, "dotProduct needs a multiple of 4 elements");
+
+#if defined(GRAINUTILS_SSE)
+    __m128 sum = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+    for (int i = 4; i < N; i += 4) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 shuf = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(sum, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+#elif defined(GRAINUTILS_NEON)
+    float32x4_t sum = vmulq_f32(vld1q_f32(a), vld1q_f32(b));
+    for (int i = 4; i < N; i += 4) {
+        sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    return vaddvq_f32(sum);
+#else
+    float sum = 0.0f;
+    for (int i = 0; i < N; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+#endif
+}
+
+// Four cubic interpolated reads at integer indices plus fractions with bitwise wrapping (for power-of-2 sizes),
+// the points are loaded per read and interpolated together
+inline void peekCubicInterp4(const float* buffer, const int* indices, const float* fracs, int mask, float* out) {
+
+    float a[4], b[4], c[4], d[4], frac[4];
+    for (int j = 0; j < 4; ++j) {
+        const int intPart = indices[j];
+        frac[j] = fracs[j];
+        a[j] = buffer[(intPart - 1) & mask];
+        b[j] = buffer[intPart & mask];
+        c[j] = buffer[(intPart + 1) & mask];
+        d[j] = buffer[(intPart + 2) & mask];
+    }
+
+#if defined(GRAINUTILS_SSE)
+    const __m128 va = _mm_loadu_ps(a);
+    const __m128 vb = _mm_loadu_ps(b);
+    const __m128 vc = _mm_loadu_ps(c);
+    const __m128 vd = _mm_loadu_ps(d);
+    const __m128 x = _mm_loadu_ps(frac);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(vc, va));
+    const __m128 c2 = _mm_sub_ps(
+        _mm_add_ps(va, _mm_add_ps(vc, vc)),
+        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.5f), vb), _mm_mul_ps(half, vd)));
+    const __m128 c3 = _mm_add_ps(
+        _mm_mul_ps(half, _mm_sub_ps(vd, va)),
+        _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(vb, vc)));
+
+    __m128 y = _mm_add_ps(_mm_mul_ps(c3, x), c2);
+    y = _mm_add_ps(_mm_mul_ps(y, x), c1);
+    y = _mm_add_ps(_mm_mul_ps(y, x), vb);
+    _mm_storeu_ps(out, y);
+#elif defined(GRAINUTILS_NEON)
+    const float32x4_t va = vld1q_f32(a);
+    const float32x4_t vb = vld1q_f32(b);
+    const float32x4_t vc = vld1q_f32(c);
+    const float32x4_t vd = vld1q_f32(d);
+    const float32x4_t x = vld1q_f32(frac);
+
+    const float32x4_t c1 = vmulq_n_f32(vsubq_f32(vc, va), 0.5f);
+    const float32x4_t c2 = vsubq_f32(
+        vaddq_f32(va, vaddq_f32(vc, vc)),
+        vaddq_f32(vmulq_n_f32(vb, 2.5f), vmulq_n_f32(vd, 0.5f)));
+    const float32x4_t c3 = vaddq_f32(
+        vmulq_n_f32(vsubq_f32(vd, va), 0.5f),
+        vmulq_n_f32(vsubq_f32(vb, vc), 1.5f));
+
+    float32x4_t y = vmlaq_f32(c2, c3, x);
+    y = vmlaq_f32(c1, y, x);
+    y = vmlaq_f32(vb, y, x);
+    vst1q_f32(out, y);
+#else
+    for (int j = 0; j < 4; ++j) {
+        out[j] = cubicinterp(frac[j], a[j], b[j], c[j], d[j]);
+    }
+#endif
+}
+
+// Four cubic interpolated reads with bitwise wrapping (for power-of-2 sizes)
+inline void peekCubicInterp4(const float* buffer, const float* phases, int mask, float* out) {
+
+    int indices[4];
+    float fracs[4];
+    for (int j = 0; j < 4; ++j) {
+        indices[j] = static_cast<int>(phases[j]);
+        fracs[j] = phases[j] - static_cast<float>(indices[j]);
+    }
+
+    peekCubicInterp4(buffer, indices, fracs, mask, out);
+}
+
+// Hanning window of four phases, see hanningWindow
+inline void hanningWindow4(const float* phases, float* out) {
+
+#if defined(GRAINUTILS_SSE)
+    const __m128 y = _mm_sub_ps(
+        _mm_min_ps(_mm_max_ps(_mm_loadu_ps(phases), _mm_setzero_ps()), _mm_set1_ps(1.0f)),
+        _mm_set1_ps(0.5f));
+    const __m128 z = _mm_mul_ps(y, y);
+
+    __m128 c = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(HANNING_POLY[4])), _mm_set1_ps(HANNING_POLY[3]));
+    c = _mm_add_ps(_mm_mul_ps(z, c), _mm_set1_ps(HANNING_POLY[2]));
+    c = _mm_add_ps(_mm_mul_ps(z, c), _mm_set1_ps(HANNING_POLY[1]));
+    c = _mm_add_ps(_mm_mul_ps(z, c), _mm_set1_ps(HANNING_POLY[0]));
+    c = _mm_add_ps(_mm_mul_ps(z, c), _mm_set1_ps(1.0f));
+    _mm_storeu_ps(out, _mm_mul_ps(c, c));
+#elif defined(GRAINUTILS_NEON)
+    const float32x4_t y = vsubq_f32(
+        vminq_f32(vmaxq_f32(vld1q_f32(phases), vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f)),
+        vdupq_n_f32(0.5f));
+    const float32x4_t z = vmulq_f32(y, y);
+
+    float32x4_t c = vmlaq_n_f32(vdupq_n_f32(HANNING_POLY[3]), z, HANNING_POLY[4]);
+    c = vmlaq_f32(vdupq_n_f32(HANNING_POLY[2]), z, c);
+    c = vmlaq_f32(vdupq_n_f32(HANNING_POLY[1]), z, c);
+    c = vmlaq_f32(vdupq_n_f32(HANNING_POLY[0]), z, c);
+    c = vmlaq_f32(vdupq_n_f32(1.0f), z, c);
+    vst1q_f32(out, vmulq_f32(c, c));
+#else
+    for (int j = 0; j < 4; ++j) {
+        out[j] = hanningWindow(phases[j]);
+    }
+#endif
+}
+
 // ===== BIT MANIPULATION UTILITIES =====
 
+// Index of the lowest set bit, x must not be zero
+inline int countTrailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
 inline int rotateBits(int value, int rotation, int length) {
     // Use wrap instead of % to handle negative rotation amount
     int normalizedRotation = sc_wrap(rotation, 0, length - 1);
@@ -0,0 +1,143 @@
+// Block paths of the schedulers against their per-sample paths, with random rates, durations, cycle counts and resets.
+// Control-rate inputs change once per block and a reset or burst trigger only fires on its first sample,
+// as in the UGens. Every output has to be identical.
+
+#include "EventUtils.hpp"
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr int NUM_TRIALS = 2000;
+constexpr int NUM_BLOCKS = 200;
+constexpr int BLOCK_SIZE = 64;
+constexpr float SAMPLE_RATE = 48000.0f;
+
+struct Block {
+    float trigger[BLOCK_SIZE];
+    float phase[BLOCK_SIZE];
+    float rate[BLOCK_SIZE];
+    float offset[BLOCK_SIZE];
+};
+
+int compare(const Block& block, const Block& reference) {
+    int mismatches = 0;
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        mismatches += block.trigger[i] != reference.trigger[i];
+        mismatches += block.phase[i] != reference.phase[i];
+        mismatches += block.rate[i] != reference.rate[i];
+        mismatches += block.offset[i] != reference.offset[i];
+        mismatches += !(block.phase[i] < 1.0f);
+    }
+    return mismatches;
+}
+
+int testSchedulerCycle(std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    int mismatches = 0;
+
+    for (int trial = 0; trial < NUM_TRIALS; ++trial) {
+        EventUtils::SchedulerCycle blockScheduler;
+        EventUtils::SchedulerCycle sampleScheduler;
+        blockScheduler.reset();
+        sampleScheduler.reset();
+
+        // Mostly slow rates with block-path slopes, some fast ones up to the UGen's clip
+        float rate = 0.0f;
+        for (int b = 0; b < NUM_BLOCKS; ++b) {
+            if (unit(rng) < 0.2f) {
+                rate = unit(rng) < 0.8f ? 1.0f + unit(rng) * 2000.0f : unit(rng) * SAMPLE_RATE * 0.49f;
+            }
+            const bool reset = unit(rng) < 0.05f;
+
+            Block block;
+            if (reset) {
+                blockScheduler.reset();
+            }
+            if (!blockScheduler.processBlock(rate, SAMPLE_RATE, BLOCK_SIZE, block.trigger, block.phase, block.rate, block.offset)) {
+                for (int i = 0; i < BLOCK_SIZE; ++i) {
+                    const auto event = blockScheduler.process(rate, false, SAMPLE_RATE);
+                    block.trigger[i] = event.trigger;
+                    block.phase[i] = event.phase;
+                    block.rate[i] = event.rate;
+                    block.offset[i] = event.subSampleOffset;
+                }
+            }
+
+            Block reference;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                const auto event = sampleScheduler.process(rate, reset && i == 0, SAMPLE_RATE);
+                reference.trigger[i] = event.trigger;
+                reference.phase[i] = event.phase;
+                reference.rate[i] = event.rate;
+                reference.offset[i] = event.subSampleOffset;
+            }
+
+            mismatches += compare(block, reference);
+        }
+    }
+    return mismatches;
+}
+
+int testSchedulerBurst(std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    int mismatches = 0;
+
+    for (int trial = 0; trial < NUM_TRIALS; ++trial) {
+        EventUtils::SchedulerBurst blockScheduler;
+        EventUtils::SchedulerBurst sampleScheduler;
+        blockScheduler.reset();
+        sampleScheduler.reset();
+
+        float duration = 0.01f;
+        int cycles = 1;
+        for (int b = 0; b < NUM_BLOCKS; ++b) {
+            if (unit(rng) < 0.2f) {
+                duration = unit(rng) < 0.8f ? 0.0005f + unit(rng) * 0.05f : unit(rng) * 0.0002f;
+                duration = sc_max(duration, 1.0f / SAMPLE_RATE);
+                cycles = 1 + static_cast<int>(unit(rng) * 8.0f);
+            }
+            const bool trigger = unit(rng) < 0.1f;
+
+            Block block;
+            if (trigger) {
+                blockScheduler.start();
+            }
+            if (!blockScheduler.processBlock(duration, cycles, SAMPLE_RATE, BLOCK_SIZE, block.trigger, block.phase, block.rate, block.offset)) {
+                for (int i = 0; i < BLOCK_SIZE; ++i) {
+                    const auto event = blockScheduler.process(false, duration, cycles, SAMPLE_RATE);
+                    block.trigger[i] = event.trigger;
+                    block.phase[i] = event.phase;
+                    block.rate[i] = event.rate;
+                    block.offset[i] = event.subSampleOffset;
+                }
+            }
+
+            Block reference;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                const auto event = sampleScheduler.process(trigger && i == 0, duration, cycles, SAMPLE_RATE);
+                reference.trigger[i] = event.trigger;
+                reference.phase[i] = event.phase;
+                reference.rate[i] = event.rate;
+                reference.offset[i] = event.subSampleOffset;
+            }
+
+            mismatches += compare(block, reference);
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(1234);
+
+    const int cycleMismatches = testSchedulerCycle(rng);
+    const int burstMismatches = testSchedulerBurst(rng);
+
+    std::printf("SchedulerCycle: %d mismatches\n", cycleMismatches);
+    std::printf("SchedulerBurst: %d mismatches\n", burstMismatches);
+
+    return (cycleMismatches == 0 && burstMismatches == 0) ? 0 : 1;
+}